@@ -0,0 +1,90 @@
+#ifndef ALLOC_TRACER_H
+#define ALLOC_TRACER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ALLOC_REGION_ATTRIBUTE_CALLBACK = 0,
+    ALLOC_REGION_RELAY_SET,
+    ALLOC_REGION_MATTER_UPDATE,
+    ALLOC_REGION_DIAGNOSTIC_LOG,
+    ALLOC_REGION_COUNT,
+} alloc_region_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t bytes;
+} alloc_region_stats_t;
+
+#if CONFIG_APP_ALLOC_TRACER
+
+/**
+ * @brief Marks a region as active on the calling task.
+ *
+ * Regions nest. An allocation is counted against every region active on the allocating task.
+ *
+ * @param[in] region Region being entered.
+ * @return Set of regions that were active before, to be passed to alloc_tracer_exit().
+ */
+uint32_t alloc_tracer_enter(alloc_region_t region);
+
+/**
+ * @brief Restores the set of active regions returned by the matching alloc_tracer_enter().
+ *
+ * @param[in] previous Set of regions returned by alloc_tracer_enter().
+ */
+void alloc_tracer_exit(uint32_t previous);
+
+/**
+ * @brief Copies the allocation counters of a region.
+ *
+ * @param[in]  region Region to query.
+ * @param[out] stats  Allocation count and bytes attributed to the region since boot.
+ */
+void alloc_tracer_get(alloc_region_t region, alloc_region_stats_t *stats);
+
+/**
+ * @brief Checks that a region did not allocate since the previous check.
+ *
+ * The first check of a region only records a baseline, so lazily allocated buffers are not reported.
+ * Later allocations are logged as errors, and abort the device when CONFIG_APP_ALLOC_TRACER_ABORT is set.
+ * May be called from several tasks; each allocation is reported by one check only.
+ *
+ * @param[in] region Region to check.
+ * @return true if the region did not allocate since the previous check.
+ */
+bool alloc_tracer_check(alloc_region_t region);
+
+#else
+
+static inline uint32_t alloc_tracer_enter(alloc_region_t region) { return 0; }
+static inline void alloc_tracer_exit(uint32_t previous) {}
+static inline void alloc_tracer_get(alloc_region_t region, alloc_region_stats_t *stats) { stats->count = 0; stats->bytes = 0; }
+static inline bool alloc_tracer_check(alloc_region_t region) { return true; }
+
+#endif // CONFIG_APP_ALLOC_TRACER
+
+#ifdef __cplusplus
+}
+
+// Keeps a region active until the end of the enclosing scope.
+class AllocTraceScope {
+public:
+    explicit AllocTraceScope(alloc_region_t region) : previous(alloc_tracer_enter(region)) {}
+    ~AllocTraceScope() { alloc_tracer_exit(previous); }
+
+    AllocTraceScope(const AllocTraceScope &) = delete;
+    AllocTraceScope &operator=(const AllocTraceScope &) = delete;
+
+private:
+    uint32_t previous;
+};
+#endif
+
+#endif // ALLOC_TRACER_H
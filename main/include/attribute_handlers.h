@@ -0,0 +1,113 @@
+#ifndef ATTRIBUTE_HANDLERS_H
+#define ATTRIBUTE_HANDLERS_H
+
+#include <esp_err.h>
+#include <esp_matter.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Dispatches an attribute update to the handler registered for its cluster/attribute path.
+ *
+ * Handlers live in a compile-time table sorted by (cluster, attribute), so a lookup is a binary search.
+ * Each handler declares the value type it accepts and whether it runs on PRE_UPDATE or POST_UPDATE.
+ * Paths or phases without a handler are accepted unchanged.
+ *
+ * @param[in] type         Type of attribute callback (e.g., pre-update or post-update).
+ * @param[in] endpoint_id  ID of the endpoint containing the updated attribute.
+ * @param[in] cluster_id   ID of the cluster containing the updated attribute.
+ * @param[in] attribute_id ID of the attribute being updated.
+ * @param[in,out] val      Pointer to the new attribute value.
+ * @return
+ *      - ESP_OK if no handler matched or the handler succeeded.
+ *      - ESP_ERR_INVALID_ARG if the value is missing or does not have the type the handler expects.
+ *      - Error codes returned by the handler.
+ */
+esp_err_t attribute_handlers_dispatch(esp_matter::attribute::callback_type_t type, uint16_t endpoint_id,
+                                      uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+
+#ifdef __cplusplus
+}
+#endif
+
+typedef esp_err_t (*attribute_handler_fn)(uint16_t endpoint_id, esp_matter_attr_val_t *val);
+
+typedef struct {
+    uint64_t key;  // attribute_key(cluster, attribute)
+    esp_matter_val_type_t val_type;
+    esp_matter::attribute::callback_type_t phase;
+    attribute_handler_fn handler;
+} attribute_handler_t;
+
+static constexpr uint64_t attribute_key(uint32_t cluster_id, uint32_t attribute_id) {
+    return ((uint64_t)cluster_id << 32) | attribute_id;
+}
+
+/**
+ * @brief Tells whether a handler table is sorted by key, as attribute_handler_table_dispatch() requires.
+ *
+ * @param[in] table Handler table.
+ * @param[in] count Number of entries in the table.
+ * @return true if no entry has a smaller key than the one before it.
+ */
+static constexpr bool attribute_handler_table_sorted(const attribute_handler_t *table, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        if (table[i - 1].key > table[i].key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the handler of a sorted table that matches the key and phase.
+ *
+ * attribute_handlers_dispatch() applies this to the application's table; it is exposed so the lookup can be
+ * exercised on other tables. Several entries may share a key when they run in different phases.
+ *
+ * @param[in] table       Handler table, sorted by key.
+ * @param[in] count       Number of entries in the table.
+ * @param[in] type        Callback phase.
+ * @param[in] endpoint_id Endpoint passed on to the handler.
+ * @param[in] key         attribute_key() of the updated attribute.
+ * @param[in,out] val     Value passed on to the handler.
+ * @return
+ *      - ESP_OK if no entry matched or the handler succeeded.
+ *      - ESP_ERR_INVALID_ARG if the value is missing or does not have the type the entry expects.
+ *      - Error codes returned by the handler.
+ */
+static inline esp_err_t attribute_handler_table_dispatch(const attribute_handler_t *table, size_t count,
+                                                         esp_matter::attribute::callback_type_t type,
+                                                         uint16_t endpoint_id, uint64_t key,
+                                                         esp_matter_attr_val_t *val) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (table[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (size_t i = low; i < count && table[i].key == key; i++) {
+        const attribute_handler_t *entry = &table[i];
+        if (entry->phase != type) {
+            continue;
+        }
+        if (val == nullptr || val->type != entry->val_type) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return entry->handler(endpoint_id, val);
+    }
+
+    return ESP_OK;
+}
+
+#endif // ATTRIBUTE_HANDLERS_H
@@ -0,0 +1,41 @@
+#ifndef DIAGNOSTIC_LOGS_H
+#define DIAGNOSTIC_LOGS_H
+
+#include <esp_err.h>
+#include <esp_matter.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Adds the Diagnostic Logs cluster to the root endpoint and starts capturing device logs.
+ *
+ * ESP log output is mirrored into a fixed-size on-device ring buffer that backs the end-user support
+ * intent. Network events recorded with diagnostic_logs_record_network() back the network diagnostics
+ * intent, and the core dump partition (when enabled) backs the crash logs intent. Controllers retrieve
+ * the logs over BDX, one transfer block at a time, straight from these buffers.
+ *
+ * @param[in] matter_node Pointer to the Matter node whose root endpoint receives the cluster.
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_ERR_INVALID_ARG if the node is null.
+ *      - ESP_FAIL if the root endpoint or the cluster cannot be created.
+ */
+esp_err_t diagnostic_logs_init(esp_matter::node_t *matter_node);
+
+/**
+ * @brief Appends a line to the network diagnostics log.
+ *
+ * Safe to call from any task. The line is formatted printf-style, timestamped and copied into the network
+ * log ring buffer, overwriting the oldest entries when the buffer is full.
+ *
+ * @param[in] fmt printf-style format describing the network event and its data.
+ */
+void diagnostic_logs_record_network(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DIAGNOSTIC_LOGS_H
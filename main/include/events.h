@@ -20,6 +20,14 @@ extern "C" {
  */
 void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg);
 
+/**
+ * @brief Records the heap size against which the BLE memory release is reported.
+ *
+ * Must be called after any other BT memory release and before the Matter stack is started. The
+ * kBLEDeinitialized event then logs how much BT memory the release added to the heap.
+ */
+void matter_event_heap_baseline(void);
+
 /**
  * @brief Callback for processing identification cluster commands.
  *
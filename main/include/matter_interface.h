@@ -54,6 +54,36 @@ esp_err_t create_on_off_endpoint(esp_matter::node_t *matter_node, uint16_t *endp
 
 uint16_t matter_get_relay_endpoint_id(void);
 
+/**
+ * @brief Tells whether an endpoint drives a relay, either the local one or a bridged one.
+ *
+ * @param[in] endpoint_id Endpoint to check.
+ * @return true if matter_relay_set() can switch the endpoint.
+ */
+bool matter_is_relay_endpoint(uint16_t endpoint_id);
+
+/**
+ * @brief Switches the relay behind an endpoint.
+ *
+ * The local relay is switched immediately; a bridged relay is queued for the next Modbus write.
+ *
+ * @param[in] endpoint_id Relay endpoint.
+ * @param[in] state       New relay state.
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_ERR_NOT_FOUND if the endpoint does not drive a relay.
+ *      - Error codes from the relay driver for other failures.
+ */
+esp_err_t matter_relay_set(uint16_t endpoint_id, bool state);
+
+/**
+ * @brief Returns the state of the relay behind an endpoint, or false if it does not drive one.
+ *
+ * @param[in] endpoint_id Relay endpoint.
+ * @return Current (or, for a bridged relay, requested) relay state.
+ */
+bool matter_relay_get(uint16_t endpoint_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,89 @@
+#ifndef MODBUS_RTU_H
+#define MODBUS_RTU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_err.h>
+
+#include "modbus_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Coils are exchanged as bit masks, so a single transaction covers at most 32 coils.
+#define MODBUS_RTU_MAX_COILS 32
+#define MODBUS_RTU_MAX_FRAME 16
+
+// Frames are separated by 3.5 character times of silence (11 bits per character); above 19200 baud the
+// specification fixes the gap at 1750 us.
+#define MODBUS_RTU_FRAME_GAP_US(baud_rate) ((baud_rate) > 19200 ? 1750 : 38500000 / (baud_rate))
+
+/**
+ * @brief Computes the Modbus RTU CRC-16 of a buffer.
+ *
+ * @param[in] data Bytes to checksum.
+ * @param[in] len  Number of bytes.
+ * @return CRC in host order; it is sent low byte first.
+ */
+uint16_t modbus_rtu_crc16(const uint8_t *data, size_t len);
+
+/**
+ * @brief Builds a Read Coils (0x01) request.
+ *
+ * @param[out] frame Buffer of at least MODBUS_RTU_MAX_FRAME bytes.
+ * @param[in]  slave Slave address.
+ * @param[in]  start First coil address.
+ * @param[in]  count Number of coils, 1 to MODBUS_RTU_MAX_COILS.
+ * @return Frame length in bytes.
+ */
+size_t modbus_rtu_build_read_coils(uint8_t *frame, uint8_t slave, uint16_t start, uint16_t count);
+
+/**
+ * @brief Builds a Write Multiple Coils (0x0F) request.
+ *
+ * @param[out] frame  Buffer of at least MODBUS_RTU_MAX_FRAME bytes.
+ * @param[in]  slave  Slave address.
+ * @param[in]  start  First coil address.
+ * @param[in]  count  Number of coils, 1 to MODBUS_RTU_MAX_COILS.
+ * @param[in]  values Coil states, bit 0 being the coil at start.
+ * @return Frame length in bytes.
+ */
+size_t modbus_rtu_build_write_coils(uint8_t *frame, uint8_t slave, uint16_t start, uint16_t count, uint32_t values);
+
+/**
+ * @brief Reads a range of coils in one transaction.
+ *
+ * @param[in]  transport Bus transport.
+ * @param[in]  slave     Slave address.
+ * @param[in]  start     First coil address.
+ * @param[in]  count     Number of coils, 1 to MODBUS_RTU_MAX_COILS.
+ * @param[out] values    Coil states, bit 0 being the coil at start.
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_ERR_INVALID_ARG if count is out of range.
+ *      - ESP_ERR_TIMEOUT if the slave did not answer in time.
+ *      - ESP_ERR_INVALID_RESPONSE on a malformed or exception response.
+ *      - ESP_ERR_INVALID_CRC on a checksum mismatch.
+ */
+esp_err_t modbus_rtu_read_coils(const modbus_transport_t *transport, uint8_t slave, uint16_t start, uint16_t count,
+                                uint32_t *values);
+
+/**
+ * @brief Writes a range of coils in one transaction.
+ *
+ * @param[in] transport Bus transport.
+ * @param[in] slave     Slave address.
+ * @param[in] start     First coil address.
+ * @param[in] count     Number of coils, 1 to MODBUS_RTU_MAX_COILS.
+ * @param[in] values    Coil states, bit 0 being the coil at start.
+ * @return Same as modbus_rtu_read_coils().
+ */
+esp_err_t modbus_rtu_write_coils(const modbus_transport_t *transport, uint8_t slave, uint16_t start, uint16_t count,
+                                 uint32_t values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MODBUS_RTU_H
@@ -0,0 +1,44 @@
+#ifndef MODBUS_TRANSPORT_H
+#define MODBUS_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Byte transport underneath the Modbus RTU master.
+ *
+ * The bridge only talks to the bus through these functions, so a UART, a Linux pty or a simulated slave
+ * can be plugged in without touching the protocol code.
+ */
+typedef struct {
+    // Discards any bytes received so far.
+    void (*flush)(void *ctx);
+    // Sends the whole buffer; returns once the frame has left the transmitter.
+    esp_err_t (*write)(void *ctx, const uint8_t *data, size_t len);
+    // Reads up to len bytes, waiting at most timeout_ms; returns the number of bytes read or -1 on error.
+    int (*read)(void *ctx, uint8_t *data, size_t len, uint32_t timeout_ms);
+    void *ctx;
+} modbus_transport_t;
+
+/**
+ * @brief Configures the RS-485 UART from the Matter Relay bridge settings and returns it as a transport.
+ *
+ * The UART runs in RS-485 half-duplex mode with RTS driving the transceiver's driver-enable pin.
+ *
+ * @param[out] transport Transport bound to the UART.
+ * @return
+ *      - ESP_OK on success.
+ *      - Error codes from the UART driver for other failures.
+ */
+esp_err_t modbus_transport_uart_init(modbus_transport_t *transport);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MODBUS_TRANSPORT_H
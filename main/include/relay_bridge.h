@@ -0,0 +1,92 @@
+#ifndef RELAY_BRIDGE_H
+#define RELAY_BRIDGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <esp_matter.h>
+
+#include "modbus_transport.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_APP_BRIDGE_ENABLED
+
+/**
+ * @brief Creates bridged On/Off endpoints for the downstream Modbus RTU relay modules.
+ *
+ * An aggregator endpoint is created with one bridged node per coil, for CONFIG_APP_BRIDGE_MODULE_COUNT
+ * modules starting at CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS, each with CONFIG_APP_BRIDGE_COILS_PER_MODULE
+ * coils. Must be called before the Matter stack is started.
+ *
+ * @param[in] matter_node Pointer to the Matter node to which the endpoints are added.
+ * @param[in] transport   Bus transport; copied, so it may live on the caller's stack.
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_ERR_INVALID_ARG if an argument is null.
+ *      - ESP_FAIL if an endpoint cannot be created.
+ */
+esp_err_t relay_bridge_init(esp_matter::node_t *matter_node, const modbus_transport_t *transport);
+
+/**
+ * @brief Starts the task that polls the modules and applies pending writes.
+ *
+ * Each cycle first sends one Write Multiple Coils request per module with pending changes, then one
+ * Read Coils request per module. Only coils whose state differs from the last reported one are pushed
+ * to the Matter attributes. A cycle starts every CONFIG_APP_BRIDGE_POLL_INTERVAL_MS, or once requests
+ * have stopped arriving for a short settle window of at least one tick.
+ *
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_FAIL if the task cannot be created.
+ */
+esp_err_t relay_bridge_start(void);
+
+/**
+ * @brief Tells whether an endpoint is one of the bridged relays.
+ *
+ * @param[in] endpoint_id Endpoint to check.
+ * @return true if the endpoint maps to a downstream coil.
+ */
+bool relay_bridge_owns_endpoint(uint16_t endpoint_id);
+
+/**
+ * @brief Requests a new state for a bridged relay.
+ *
+ * The write is queued and coalesced with other changes to the same module into a single Modbus
+ * transaction on the next bus cycle, which starts once no further request follows within the settle
+ * window of at least one tick.
+ *
+ * @param[in] endpoint_id Bridged endpoint.
+ * @param[in] state       Requested relay state.
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_ERR_NOT_FOUND if the endpoint is not bridged.
+ *      - ESP_ERR_INVALID_STATE if the module did not answer its last poll; nothing is queued.
+ */
+esp_err_t relay_bridge_set(uint16_t endpoint_id, bool state);
+
+/**
+ * @brief Returns the requested state of a bridged relay.
+ *
+ * @param[in] endpoint_id Bridged endpoint.
+ * @return The pending state if a write is queued, otherwise the last state read from the module.
+ */
+bool relay_bridge_get(uint16_t endpoint_id);
+
+#else
+
+static inline bool relay_bridge_owns_endpoint(uint16_t endpoint_id) { return false; }
+static inline esp_err_t relay_bridge_set(uint16_t endpoint_id, bool state) { return ESP_ERR_NOT_FOUND; }
+static inline bool relay_bridge_get(uint16_t endpoint_id) { return false; }
+
+#endif // CONFIG_APP_BRIDGE_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RELAY_BRIDGE_H
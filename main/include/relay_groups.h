@@ -0,0 +1,41 @@
+#ifndef RELAY_GROUPS_H
+#define RELAY_GROUPS_H
+
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Registers the group command fan-out for relay endpoints.
+ *
+ * A group OnOff command is dispatched by the Matter stack once per member endpoint. On the first
+ * dispatch of a message, all member relays where the group holds Operate privilege are switched
+ * together, using a precomputed (fabric, group) -> endpoint index. The remaining dispatches of that
+ * message, recognized by its sender and exchange, only update the attributes. The index is rebuilt
+ * lazily after Groups cluster commands or fabric removal. It holds CONFIG_APP_GROUPS_PER_RELAY
+ * memberships per relay; memberships beyond that are logged as an error and switched by their own
+ * dispatch instead.
+ *
+ * Must be called after the Matter stack has been started.
+ *
+ * @return
+ *      - ESP_OK on success.
+ *      - ESP_FAIL if the command handlers cannot be scheduled for registration.
+ */
+esp_err_t relay_groups_init(void);
+
+/**
+ * @brief Marks the group-to-endpoint index as stale.
+ *
+ * The index is rebuilt on the next group command. Call this whenever group membership may have changed
+ * outside the Groups cluster, for example when a fabric is removed.
+ */
+void relay_groups_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RELAY_GROUPS_H
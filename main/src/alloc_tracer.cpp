@@ -0,0 +1,84 @@
+#include "alloc_tracer.h"
+
+#if CONFIG_APP_ALLOC_TRACER
+
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+
+#include <atomic>
+#include <stdlib.h>
+#include <inttypes.h>
+
+static const char *TAG = "ALLOC_TRACER";
+
+static const char *region_names[ALLOC_REGION_COUNT] = {
+    "attribute_callback",
+    "relay_set",
+    "matter_update",
+    "diagnostic_log",
+};
+
+static std::atomic<uint32_t> region_count[ALLOC_REGION_COUNT];
+static std::atomic<uint32_t> region_bytes[ALLOC_REGION_COUNT];
+// Count seen by the latest check of each region plus one, or zero before its first check. Regions are
+// checked from more than one task, so this only ever moves forward.
+static std::atomic<uint32_t> checked_count[ALLOC_REGION_COUNT];
+
+// Bit set of regions active on the current task.
+static __thread uint32_t active_regions = 0;
+
+uint32_t alloc_tracer_enter(alloc_region_t region) {
+    uint32_t previous = active_regions;
+    active_regions = previous | (1U << region);
+    return previous;
+}
+
+void alloc_tracer_exit(uint32_t previous) {
+    active_regions = previous;
+}
+
+void alloc_tracer_get(alloc_region_t region, alloc_region_stats_t *stats) {
+    stats->count = region_count[region].load(std::memory_order_relaxed);
+    stats->bytes = region_bytes[region].load(std::memory_order_relaxed);
+}
+
+bool alloc_tracer_check(alloc_region_t region) {
+    alloc_region_stats_t stats;
+    alloc_tracer_get(region, &stats);
+
+    // Only the check that moves the baseline forward reports the allocations it covers, so concurrent
+    // checks report each allocation once.
+    uint32_t seen = stats.count + 1;
+    uint32_t previous = checked_count[region].load(std::memory_order_relaxed);
+    while (seen > previous &&
+           !checked_count[region].compare_exchange_weak(previous, seen, std::memory_order_relaxed)) {
+    }
+
+    bool clean = previous == 0 || seen <= previous;
+    if (!clean) {
+        ESP_LOGE(TAG, "Region %s allocated in steady state: %" PRIu32 " new, %" PRIu32 " allocations, %" PRIu32
+                      " bytes since boot",
+                 region_names[region], seen - previous, stats.count, stats.bytes);
+#if CONFIG_APP_ALLOC_TRACER_ABORT
+        abort();
+#endif
+    }
+    return clean;
+}
+
+// Heap hooks run inside every successful allocation, so they only touch thread-local and atomic state.
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps) {
+    uint32_t active = active_regions;
+    while (active != 0) {
+        int region = __builtin_ctz(active);
+        active &= active - 1;
+        region_count[region].fetch_add(1, std::memory_order_relaxed);
+        region_bytes[region].fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void *ptr) {
+}
+
+#endif // CONFIG_APP_ALLOC_TRACER
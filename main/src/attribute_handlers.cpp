@@ -0,0 +1,32 @@
+#include "attribute_handlers.h"
+#include "matter_interface.h"
+
+#include <esp_matter.h>
+#include <esp_matter_attribute_utils.h>
+
+using esp_matter::attribute::callback_type_t;
+using namespace chip::app::Clusters;
+
+static esp_err_t on_off_pre_update(uint16_t endpoint_id, esp_matter_attr_val_t *val) {
+    if (!matter_is_relay_endpoint(endpoint_id)) {
+        return ESP_OK;
+    }
+    return matter_relay_set(endpoint_id, val->val.b);
+}
+
+// Must stay sorted by key. Several handlers may share a key when they run in different phases.
+static constexpr attribute_handler_t attribute_handlers[] = {
+    {attribute_key(OnOff::Id, OnOff::Attributes::OnOff::Id), ESP_MATTER_VAL_TYPE_BOOLEAN,
+     callback_type_t::PRE_UPDATE, on_off_pre_update},
+};
+
+static constexpr size_t attribute_handler_count = sizeof(attribute_handlers) / sizeof(attribute_handlers[0]);
+
+static_assert(attribute_handler_table_sorted(attribute_handlers, attribute_handler_count),
+              "attribute_handlers must be sorted by (cluster, attribute)");
+
+esp_err_t attribute_handlers_dispatch(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                      uint32_t attribute_id, esp_matter_attr_val_t *val) {
+    return attribute_handler_table_dispatch(attribute_handlers, attribute_handler_count, type, endpoint_id,
+                                            attribute_key(cluster_id, attribute_id), val);
+}
@@ -0,0 +1,336 @@
+#include "diagnostic_logs.h"
+#include "alloc_tracer.h"
+
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <freertos/FreeRTOS.h>
+#include <app/clusters/diagnostic-logs-server/DiagnosticLogsProviderDelegate.h>
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+#include <esp_core_dump.h>
+#include <esp_flash.h>
+#endif
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#define END_USER_LOG_SIZE 4096
+#define NETWORK_LOG_SIZE 1024
+#define LOG_LINE_MAX 128
+#define MAX_LOG_SESSIONS 2
+
+using chip::MutableByteSpan;
+using chip::Optional;
+using namespace chip::app::Clusters::DiagnosticLogs;
+
+static const char *TAG = "DIAGNOSTIC_LOGS";
+
+// Byte ring buffer. head counts every byte ever written, so a reader holding an absolute
+// offset can tell how much of its range has been overwritten since it started.
+typedef struct {
+    uint8_t *data;
+    size_t capacity;
+    uint32_t head;
+    portMUX_TYPE lock;
+} log_ring_t;
+
+typedef struct {
+    bool in_use;
+    IntentEnum intent;
+    uint32_t next;
+    uint32_t end;
+} log_session_t;
+
+static uint8_t end_user_log_data[END_USER_LOG_SIZE];
+static uint8_t network_log_data[NETWORK_LOG_SIZE];
+
+static log_ring_t end_user_log = {end_user_log_data, END_USER_LOG_SIZE, 0, portMUX_INITIALIZER_UNLOCKED};
+static log_ring_t network_log = {network_log_data, NETWORK_LOG_SIZE, 0, portMUX_INITIALIZER_UNLOCKED};
+
+static log_session_t sessions[MAX_LOG_SESSIONS];
+static vprintf_like_t previous_vprintf = NULL;
+
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+static size_t crash_log_address = 0;
+#endif
+
+static void ring_write(log_ring_t *ring, const char *src, size_t len) {
+    if (len > ring->capacity) {
+        src += len - ring->capacity;
+        len = ring->capacity;
+    }
+
+    taskENTER_CRITICAL(&ring->lock);
+    size_t pos = ring->head % ring->capacity;
+    size_t first = ring->capacity - pos;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(ring->data + pos, src, first);
+    memcpy(ring->data, src + first, len - first);
+    ring->head += len;
+    taskEXIT_CRITICAL(&ring->lock);
+}
+
+static uint32_t ring_head(log_ring_t *ring) {
+    taskENTER_CRITICAL(&ring->lock);
+    uint32_t head = ring->head;
+    taskEXIT_CRITICAL(&ring->lock);
+    return head;
+}
+
+static uint32_t ring_oldest(log_ring_t *ring) {
+    uint32_t head = ring_head(ring);
+    return head > ring->capacity ? head - ring->capacity : 0;
+}
+
+// Copies up to max_len bytes starting at the absolute offset *next, never past end.
+// Bytes overwritten since the session started are skipped rather than returned stale.
+static size_t ring_read(log_ring_t *ring, uint32_t *next, uint32_t end, uint8_t *dst, size_t max_len) {
+    taskENTER_CRITICAL(&ring->lock);
+    if (ring->head - *next > ring->capacity) {
+        *next = ring->head - ring->capacity;
+    }
+
+    size_t len = end > *next ? end - *next : 0;
+    if (len > max_len) {
+        len = max_len;
+    }
+
+    size_t pos = *next % ring->capacity;
+    size_t first = ring->capacity - pos;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(dst, ring->data + pos, first);
+    memcpy(dst + first, ring->data, len - first);
+    *next += len;
+    taskEXIT_CRITICAL(&ring->lock);
+
+    return len;
+}
+
+// Formats each line once. With the default console the formatted bytes are copied into the ring and
+// written to stdout as they are; only lines longer than the buffer, or a custom vprintf installed before
+// ours, go through the previous vprintf and its own formatting pass.
+static int capture_vprintf(const char *fmt, va_list args) {
+    AllocTraceScope trace(ALLOC_REGION_DIAGNOSTIC_LOG);
+
+    char line[LOG_LINE_MAX];
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(line, sizeof(line), fmt, copy);
+    va_end(copy);
+
+    if (len <= 0) {
+        return len;
+    }
+
+    // A truncated line keeps its newline, so the next line still starts on its own.
+    bool fits = (size_t)len < sizeof(line);
+    if (!fits) {
+        line[sizeof(line) - 2] = '\n';
+    }
+    ring_write(&end_user_log, line, fits ? (size_t)len : sizeof(line) - 1);
+
+    if (previous_vprintf == NULL) {
+        return len;
+    }
+    if (fits && previous_vprintf == &vprintf) {
+        return (int)fwrite(line, 1, len, stdout);
+    }
+    return previous_vprintf(fmt, args);
+}
+
+static log_ring_t *ring_for_intent(IntentEnum intent) {
+    switch (intent) {
+        case IntentEnum::kEndUserSupport:
+            return &end_user_log;
+        case IntentEnum::kNetworkDiag:
+            return &network_log;
+        default:
+            return nullptr;
+    }
+}
+
+static bool crash_log_get(size_t *address, size_t *size) {
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+    return esp_core_dump_image_get(address, size) == ESP_OK && *size > 0;
+#else
+    return false;
+#endif
+}
+
+class DiagnosticLogsProvider : public DiagnosticLogsProviderDelegate {
+public:
+    CHIP_ERROR StartLogCollection(IntentEnum intent, LogSessionHandle &outHandle, Optional<uint64_t> &outTimeStamp,
+                                  Optional<uint64_t> &outTimeSinceBoot) override {
+        // The capture hook logs on every task and cannot check itself, since a failed check logs. Its
+        // allocations since the previous pull are reported here instead, against the log region only.
+        alloc_tracer_check(ALLOC_REGION_DIAGNOSTIC_LOG);
+
+        LogSessionHandle handle = kInvalidLogSessionHandle;
+        for (LogSessionHandle i = 0; i < MAX_LOG_SESSIONS; i++) {
+            if (!sessions[i].in_use) {
+                handle = i;
+                break;
+            }
+        }
+        if (handle == kInvalidLogSessionHandle) {
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        log_session_t *session = &sessions[handle];
+        session->intent = intent;
+
+        if (intent == IntentEnum::kCrashLogs) {
+            size_t address = 0;
+            size_t size = 0;
+            if (!crash_log_get(&address, &size)) {
+                return CHIP_ERROR_NOT_FOUND;
+            }
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+            crash_log_address = address;
+#endif
+            session->next = 0;
+            session->end = size;
+        } else {
+            log_ring_t *ring = ring_for_intent(intent);
+            if (ring == nullptr) {
+                return CHIP_ERROR_INVALID_ARGUMENT;
+            }
+            // Snapshot the range now; lines logged during the transfer belong to the next pull.
+            session->next = ring_oldest(ring);
+            session->end = ring_head(ring);
+        }
+
+        session->in_use = true;
+        outHandle = handle;
+        outTimeSinceBoot.SetValue(static_cast<uint64_t>(esp_timer_get_time()));
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CollectLog(LogSessionHandle sessionHandle, MutableByteSpan &outBuffer, bool &outIsEndOfLog) override {
+        if (sessionHandle >= MAX_LOG_SESSIONS || !sessions[sessionHandle].in_use) {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+
+        log_session_t *session = &sessions[sessionHandle];
+        size_t len = 0;
+
+        if (session->intent == IntentEnum::kCrashLogs) {
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+            len = session->end - session->next;
+            if (len > outBuffer.size()) {
+                len = outBuffer.size();
+            }
+            esp_err_t err = esp_flash_read(esp_flash_default_chip, outBuffer.data(),
+                                           crash_log_address + session->next, len);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to read crash log: %s", esp_err_to_name(err));
+                return CHIP_ERROR_READ_FAILED;
+            }
+            session->next += len;
+#endif
+        } else {
+            len = ring_read(ring_for_intent(session->intent), &session->next, session->end,
+                            outBuffer.data(), outBuffer.size());
+        }
+
+        outBuffer.reduce_size(len);
+        outIsEndOfLog = session->next >= session->end;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR EndLogCollection(LogSessionHandle sessionHandle) override {
+        if (sessionHandle >= MAX_LOG_SESSIONS) {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        sessions[sessionHandle].in_use = false;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetSizeForIntent(IntentEnum intent) override {
+        if (intent == IntentEnum::kCrashLogs) {
+            size_t address = 0;
+            size_t size = 0;
+            return crash_log_get(&address, &size) ? size : 0;
+        }
+
+        log_ring_t *ring = ring_for_intent(intent);
+        if (ring == nullptr) {
+            return 0;
+        }
+        return ring_head(ring) - ring_oldest(ring);
+    }
+
+    CHIP_ERROR GetLogForIntent(IntentEnum intent, MutableByteSpan &outBuffer, Optional<uint64_t> &outTimeStamp,
+                               Optional<uint64_t> &outTimeSinceBoot) override {
+        LogSessionHandle handle = kInvalidLogSessionHandle;
+        CHIP_ERROR err = StartLogCollection(intent, handle, outTimeStamp, outTimeSinceBoot);
+        if (err != CHIP_NO_ERROR) {
+            outBuffer.reduce_size(0);
+            return err;
+        }
+
+        bool end_of_log = false;
+        err = CollectLog(handle, outBuffer, end_of_log);
+        EndLogCollection(handle);
+        return err;
+    }
+};
+
+static DiagnosticLogsProvider log_provider;
+
+esp_err_t diagnostic_logs_init(esp_matter::node_t *matter_node) {
+    if (matter_node == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_matter::endpoint_t *root_endpoint = esp_matter::endpoint::get(matter_node, 0);
+    if (root_endpoint == nullptr) {
+        ESP_LOGE(TAG, "Root endpoint not found.");
+        return ESP_FAIL;
+    }
+
+    esp_matter::cluster::diagnostic_logs::config_t diagnostic_logs_config;
+    diagnostic_logs_config.delegate = &log_provider;
+    esp_matter::cluster_t *cluster = esp_matter::cluster::diagnostic_logs::create(
+        root_endpoint, &diagnostic_logs_config, esp_matter::CLUSTER_FLAG_SERVER);
+    if (cluster == nullptr) {
+        ESP_LOGE(TAG, "Failed to create Diagnostic Logs cluster.");
+        return ESP_FAIL;
+    }
+
+    if (previous_vprintf == NULL) {
+        previous_vprintf = esp_log_set_vprintf(capture_vprintf);
+    }
+
+    ESP_LOGI(TAG, "Diagnostic Logs cluster created on root endpoint");
+    return ESP_OK;
+}
+
+void diagnostic_logs_record_network(const char *fmt, ...) {
+    char line[LOG_LINE_MAX];
+    int prefix = snprintf(line, sizeof(line), "[%" PRIu32 "] ", (uint32_t)(esp_timer_get_time() / 1000));
+
+    va_list args;
+    va_start(args, fmt);
+    int body = vsnprintf(line + prefix, sizeof(line) - prefix - 1, fmt, args);
+    va_end(args);
+    if (body < 0) {
+        return;
+    }
+
+    size_t len = prefix + body;
+    if (len > sizeof(line) - 2) {
+        len = sizeof(line) - 2;
+    }
+    line[len++] = '\n';
+    ring_write(&network_log, line, len);
+}
@@ -1,6 +1,8 @@
 #include "events.h"
-#include "matter_interface.h"
-#include "relay.h"
+#include "alloc_tracer.h"
+#include "attribute_handlers.h"
+#include "diagnostic_logs.h"
+#include "relay_groups.h"
 
 #include <esp_matter.h>
 #include <esp_matter_attribute_utils.h>
@@ -11,10 +13,58 @@
 
 #include <esp_log.h>
 #include <esp_err.h>
+#include <esp_heap_caps.h>
 #include <inttypes.h>
 
 static const char *TAG = "EVENTS";
 
+// Total heap size before the Matter stack started. Releasing BT memory adds its regions to the heap, so the
+// growth of the total size counts the released memory alone, whatever was allocated or freed meanwhile.
+static size_t heap_total_before_ble_release = 0;
+
+static void log_ble_release(void) {
+    size_t heap_total = heap_caps_get_total_size(MALLOC_CAP_DEFAULT);
+
+    if (heap_total_before_ble_release == 0) {
+        ESP_LOGI(TAG, "BLE deinitialized, free heap: %u bytes",
+                 (unsigned int)heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+        return;
+    }
+    ESP_LOGI(TAG, "BLE deinitialized, BT memory returned to the heap: %u bytes, free heap: %u bytes",
+             (unsigned int)(heap_total - heap_total_before_ble_release),
+             (unsigned int)heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+}
+
+static const char *connectivity_name(chip::DeviceLayer::ConnectivityChange change) {
+    switch (change) {
+        case chip::DeviceLayer::kConnectivity_Established:
+            return "established";
+        case chip::DeviceLayer::kConnectivity_Lost:
+            return "lost";
+        default:
+            return "no change";
+    }
+}
+
+static const char *ip_change_name(chip::DeviceLayer::InterfaceIpChangeType type) {
+    switch (type) {
+        case chip::DeviceLayer::InterfaceIpChangeType::kIpV4_Assigned:
+            return "IPv4 assigned";
+        case chip::DeviceLayer::InterfaceIpChangeType::kIpV4_Lost:
+            return "IPv4 lost";
+        case chip::DeviceLayer::InterfaceIpChangeType::kIpV6_Assigned:
+            return "IPv6 assigned";
+        case chip::DeviceLayer::InterfaceIpChangeType::kIpV6_Lost:
+            return "IPv6 lost";
+        default:
+            return "unknown";
+    }
+}
+
+void matter_event_heap_baseline(void) {
+    heap_total_before_ble_release = heap_caps_get_total_size(MALLOC_CAP_DEFAULT);
+}
+
 void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg) {
     switch (event->Type) {
 
@@ -52,29 +102,40 @@ void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg) {
             ESP_LOGI(TAG, "Commissioning session stopped");
             break;
 
+        // With CONFIG_USE_BLE_ONLY_FOR_COMMISSIONING the BLE controller and host memory has been returned
+        // to the heap, either after commissioning or right after start-up on an already commissioned boot.
         case chip::DeviceLayer::DeviceEventType::kBLEDeinitialized:
-            ESP_LOGI(TAG, "BLE deinitialized");
+            log_ble_release();
             set_rgb_mode(nullptr);
             break;
 
         // Signals a change in connectivity of the device's Wi-Fi station interface.
         case chip::DeviceLayer::DeviceEventType::kWiFiConnectivityChange:
             ESP_LOGI(TAG, "Wi-Fi connectivity change");
+            diagnostic_logs_record_network("Wi-Fi connectivity %s",
+                                           connectivity_name(event->WiFiConnectivityChange.Result));
             break;
 
         // Signals a change in connectivity of the device's Thread interface.
         case chip::DeviceLayer::DeviceEventType::kThreadConnectivityChange:
             ESP_LOGI(TAG, "Thread connectivity change");
+            diagnostic_logs_record_network("Thread connectivity %s",
+                                           connectivity_name(event->ThreadConnectivityChange.Result));
             break;
 
         // Signals a change in the device's ability to communicate via the internet.
         case chip::DeviceLayer::DeviceEventType::kInternetConnectivityChange:
             ESP_LOGI(TAG, "Internet connectivity change");
+            diagnostic_logs_record_network("Internet connectivity IPv4 %s, IPv6 %s",
+                                           connectivity_name(event->InternetConnectivityChange.IPv4),
+                                           connectivity_name(event->InternetConnectivityChange.IPv6));
             break;
 
         // Signals a change in the device's ability to communicate with a chip-enabled service.
         case chip::DeviceLayer::DeviceEventType::kServiceConnectivityChange:
             ESP_LOGI(TAG, "Service connectivity change");
+            diagnostic_logs_record_network("Service connectivity %s",
+                                           connectivity_name(event->ServiceConnectivityChange.Overall.Result));
             break;
 
         // Signals a change to the device's service provisioning state.
@@ -110,16 +171,22 @@ void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg) {
         // Indicates that the operational network has started.
         case chip::DeviceLayer::DeviceEventType::kOperationalNetworkStarted:
             ESP_LOGI(TAG, "Operational network started");
+            diagnostic_logs_record_network("Operational network started");
             break;
 
         // Signals a state change in the Thread stack.
         case chip::DeviceLayer::DeviceEventType::kThreadStateChange:
             ESP_LOGI(TAG, "Thread state change");
+            diagnostic_logs_record_network("Thread state change, role %s, address %s, network data %s",
+                                           event->ThreadStateChange.RoleChanged ? "changed" : "kept",
+                                           event->ThreadStateChange.AddressChanged ? "changed" : "kept",
+                                           event->ThreadStateChange.NetDataChanged ? "changed" : "kept");
             break;
 
         // Indicates a change in the state of the Thread network interface.
         case chip::DeviceLayer::DeviceEventType::kThreadInterfaceStateChange:
             ESP_LOGI(TAG, "Thread interface state change");
+            diagnostic_logs_record_network("Thread interface state change");
             break;
 
         // Indicates a change in the CHIPoBLE advertising state.
@@ -130,11 +197,14 @@ void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg) {
         // Indicates that an IP address (IPv4 or IPv6) has changed for the interface.
         case chip::DeviceLayer::DeviceEventType::kInterfaceIpAddressChanged:
             ESP_LOGI(TAG, "Interface IP address changed");
+            diagnostic_logs_record_network("Interface IP address changed, %s",
+                                           ip_change_name(event->InterfaceIpAddressChanged.Type));
             break;
 
         // Indicates that the operational network is enabled.
         case chip::DeviceLayer::DeviceEventType::kOperationalNetworkEnabled:
             ESP_LOGI(TAG, "Operational network enabled");
+            diagnostic_logs_record_network("Operational network enabled");
             break;
 
         // Signals that DNS-SD has been initialized and is ready to operate.
@@ -165,6 +235,7 @@ void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg) {
         // Indicates that a fabric has been removed.
         case chip::DeviceLayer::DeviceEventType::kFabricRemoved:
             ESP_LOGI(TAG, "Fabric removed successfully");
+            relay_groups_invalidate();
             break;
 
         // Indicates that a fabric in the Fabric Table has been committed to storage.
@@ -185,28 +256,23 @@ void matter_event_callback(const ChipDeviceEvent *event, intptr_t arg) {
 
 esp_err_t matter_attribute_update_callback(esp_matter::attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
                                            esp_matter_attr_val_t *val, void *priv_data) {
-    if (type != esp_matter::attribute::callback_type_t::PRE_UPDATE) {
+    esp_err_t err;
+    {
+        AllocTraceScope trace(ALLOC_REGION_ATTRIBUTE_CALLBACK);
+
         if (type == esp_matter::attribute::callback_type_t::POST_UPDATE) {
             ESP_LOGI(TAG, "POST_UPDATE triggered for endpoint %" PRIu32 ", cluster %" PRIu32 ", attribute %" PRIu32 ".",
                      (uint32_t)endpoint_id, (uint32_t)cluster_id, (uint32_t)attribute_id);
         }
-        return ESP_OK;
-    }
-
-    if (endpoint_id != matter_get_relay_endpoint_id()) {
-        return ESP_OK;
-    }
-
-    if (cluster_id != chip::app::Clusters::OnOff::Id ||
-        attribute_id != chip::app::Clusters::OnOff::Attributes::OnOff::Id) {
-        return ESP_OK;
-    }
 
-    if (val == nullptr || val->type != ESP_MATTER_VAL_TYPE_BOOLEAN) {
-        return ESP_ERR_INVALID_ARG;
+        err = attribute_handlers_dispatch(type, endpoint_id, cluster_id, attribute_id, val);
     }
 
-    return relay_set(val->val.b);
+    // The toggle path must not allocate once the device is up; no-op unless CONFIG_APP_ALLOC_TRACER is set.
+    // Every relay switch is followed by this callback, so the relay region is checked here.
+    alloc_tracer_check(ALLOC_REGION_ATTRIBUTE_CALLBACK);
+    alloc_tracer_check(ALLOC_REGION_RELAY_SET);
+    return err;
 }
 
 esp_err_t identification_callback(esp_matter::identification::callback_type_t const type, uint16_t const endpoint_id,
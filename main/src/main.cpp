@@ -1,6 +1,12 @@
 #include "esp_log.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
 #include "nvs_flash.h"
+#include "sdkconfig.h"
+
+#if CONFIG_BT_ENABLED && CONFIG_IDF_TARGET_ESP32
+#include "esp_bt.h"
+#endif
 
 #include "matter_interface.h"
 #include "events.h"
@@ -35,6 +41,21 @@ extern "C" void app_main() {
         ESP_LOGE(TAG, "RGB LED initialization failed: %s", esp_err_to_name(err));
     }
 
+#if CONFIG_BT_ENABLED && CONFIG_IDF_TARGET_ESP32
+    // Commissioning only uses BLE, so the Classic BT controller memory on ESP32 is never needed.
+    // It must be released before the controller is initialized by the Matter stack. The release adds
+    // the memory to the heap as new regions, so the growth of the total heap size is the amount released.
+    size_t heap_total_before = heap_caps_get_total_size(MALLOC_CAP_DEFAULT);
+    err = esp_bt_controller_mem_release(ESP_BT_MODE_CLASSIC_BT);
+    size_t heap_total_after = heap_caps_get_total_size(MALLOC_CAP_DEFAULT);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to release Classic BT memory: %s", esp_err_to_name(err));
+    } else {
+        ESP_LOGI(TAG, "Classic BT memory released, heap gained: %u bytes",
+                 (unsigned int)(heap_total_after - heap_total_before));
+    }
+#endif
+
     // Initialize Matter
     ESP_LOGI(TAG, "Initializing Matter interface...");
     uint16_t ep_id;
@@ -1,5 +1,9 @@
 #include "matter_interface.h"
+#include "alloc_tracer.h"
 #include "events.h"
+#include "diagnostic_logs.h"
+#include "relay_bridge.h"
+#include "relay_groups.h"
 #include "relay.h"
 
 #include <esp_log.h>
@@ -62,6 +66,23 @@ esp_err_t matter_init(uint16_t *endpoint_id) {
         return ESP_FAIL;
     }
 
+    // Modbus RTU relay modules on the RS-485 bus are exposed as bridged On/Off endpoints.
+#if CONFIG_APP_BRIDGE_ENABLED
+    modbus_transport_t bridge_transport;
+    if (modbus_transport_uart_init(&bridge_transport) != ESP_OK ||
+        relay_bridge_init(matter_node, &bridge_transport) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize relay bridge.");
+        return ESP_FAIL;
+    }
+#endif
+
+    // Diagnostic Logs lets a controller pull logs over BDX from units without a console attached.
+    if (diagnostic_logs_init(matter_node) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize Diagnostic Logs cluster.");
+        return ESP_FAIL;
+    }
+
+    matter_event_heap_baseline();
     esp_err_t matter_err = esp_matter::start(matter_event_callback);
     if (matter_err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to start Matter, error: %d", matter_err);
@@ -69,6 +90,18 @@ esp_err_t matter_init(uint16_t *endpoint_id) {
     }
     ESP_LOGI(TAG, "Matter started");
 
+    if (relay_groups_init() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize group command fan-out.");
+        return ESP_FAIL;
+    }
+
+#if CONFIG_APP_BRIDGE_ENABLED
+    if (relay_bridge_start() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start relay bridge.");
+        return ESP_FAIL;
+    }
+#endif
+
     // The Matter Over-The-Air is a process that allows a Matter device in a Matter fabric to update its firmware.
     // OTA Requestor is any Matter device that is going to have its firmware updated.
     // https://docs.nordicsemi.com/bundle/ncs-latest/page/nrf/protocols/matter/overview/dfu.html
@@ -102,20 +135,25 @@ esp_err_t matter_init(uint16_t *endpoint_id) {
 }
 
 esp_err_t matter_update_value(const uint16_t endpoint_id, const bool new_value) {
-    esp_matter_attr_val_t matter_new_val = esp_matter_bool(new_value);
-    const esp_err_t ret = esp_matter::attribute::update(
-        endpoint_id,
-        chip::app::Clusters::OnOff::Id,
-        chip::app::Clusters::OnOff::Attributes::OnOff::Id,
-        &matter_new_val);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to update OnOff endpoint with new value");
-        return ret;
+    esp_err_t ret;
+    {
+        AllocTraceScope trace(ALLOC_REGION_MATTER_UPDATE);
+
+        esp_matter_attr_val_t matter_new_val = esp_matter_bool(new_value);
+        ret = esp_matter::attribute::update(
+            endpoint_id,
+            chip::app::Clusters::OnOff::Id,
+            chip::app::Clusters::OnOff::Attributes::OnOff::Id,
+            &matter_new_val);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to update OnOff endpoint with new value");
+        } else {
+            ESP_LOGI(TAG, "OnOff endpoint updated with new value: %d", new_value);
+        }
     }
 
-    ESP_LOGI(TAG, "OnOff endpoint updated with new value: %d", new_value);
-
-    return ESP_OK;
+    alloc_tracer_check(ALLOC_REGION_MATTER_UPDATE);
+    return ret;
 }
 
 esp_err_t create_on_off_endpoint(esp_matter::node_t *matter_node, uint16_t *endpoint_id) {
@@ -134,6 +172,14 @@ esp_err_t create_on_off_endpoint(esp_matter::node_t *matter_node, uint16_t *endp
         return ESP_FAIL;
     }
 
+    // The on/off light device type already provides the Groups cluster; Binding completes group
+    // addressing so controllers can record group targets on this endpoint.
+    esp_matter::cluster::binding::config_t binding_config;
+    if (esp_matter::cluster::binding::create(endpoint, &binding_config, esp_matter::CLUSTER_FLAG_SERVER) == nullptr) {
+        ESP_LOGE(TAG, "Failed to create Binding cluster.");
+        return ESP_FAIL;
+    }
+
     relay_endpoint_id = esp_matter::endpoint::get_id(endpoint);
     *endpoint_id = relay_endpoint_id;
     ESP_LOGI(TAG, "Relay created with endpoint_id %d", relay_endpoint_id);
@@ -144,3 +190,21 @@ esp_err_t create_on_off_endpoint(esp_matter::node_t *matter_node, uint16_t *endp
 uint16_t matter_get_relay_endpoint_id(void) {
     return relay_endpoint_id;
 }
+
+bool matter_is_relay_endpoint(uint16_t endpoint_id) {
+    return endpoint_id == relay_endpoint_id || relay_bridge_owns_endpoint(endpoint_id);
+}
+
+esp_err_t matter_relay_set(uint16_t endpoint_id, bool state) {
+    if (endpoint_id == relay_endpoint_id) {
+        return relay_set(state);
+    }
+    return relay_bridge_set(endpoint_id, state);
+}
+
+bool matter_relay_get(uint16_t endpoint_id) {
+    if (endpoint_id == relay_endpoint_id) {
+        return relay_get();
+    }
+    return relay_bridge_get(endpoint_id);
+}
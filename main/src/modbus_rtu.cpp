@@ -0,0 +1,149 @@
+#include "modbus_rtu.h"
+
+#define FUNCTION_READ_COILS 0x01
+#define FUNCTION_WRITE_COILS 0x0F
+#define EXCEPTION_FLAG 0x80
+
+// Slave address, function code and exception code or first payload byte, plus CRC.
+#define MIN_RESPONSE_SIZE 5
+#define RESPONSE_TIMEOUT_MS 100
+
+uint16_t modbus_rtu_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static size_t append_crc(uint8_t *frame, size_t len) {
+    uint16_t crc = modbus_rtu_crc16(frame, len);
+    frame[len++] = crc & 0xFF;
+    frame[len++] = crc >> 8;
+    return len;
+}
+
+static size_t build_header(uint8_t *frame, uint8_t slave, uint8_t function, uint16_t start, uint16_t count) {
+    frame[0] = slave;
+    frame[1] = function;
+    frame[2] = start >> 8;
+    frame[3] = start & 0xFF;
+    frame[4] = count >> 8;
+    frame[5] = count & 0xFF;
+    return 6;
+}
+
+static size_t coil_bytes(uint16_t count) {
+    return (count + 7) / 8;
+}
+
+size_t modbus_rtu_build_read_coils(uint8_t *frame, uint8_t slave, uint16_t start, uint16_t count) {
+    return append_crc(frame, build_header(frame, slave, FUNCTION_READ_COILS, start, count));
+}
+
+size_t modbus_rtu_build_write_coils(uint8_t *frame, uint8_t slave, uint16_t start, uint16_t count, uint32_t values) {
+    size_t len = build_header(frame, slave, FUNCTION_WRITE_COILS, start, count);
+    size_t bytes = coil_bytes(count);
+    frame[len++] = bytes;
+    for (size_t i = 0; i < bytes; i++) {
+        frame[len++] = (values >> (8 * i)) & 0xFF;
+    }
+    return append_crc(frame, len);
+}
+
+// Sends a request and receives a response of the expected size, or a shorter exception response.
+static esp_err_t transact(const modbus_transport_t *transport, const uint8_t *request, size_t request_len,
+                          uint8_t *response, size_t response_len) {
+    transport->flush(transport->ctx);
+
+    esp_err_t err = transport->write(transport->ctx, request, request_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    int read = transport->read(transport->ctx, response, MIN_RESPONSE_SIZE, RESPONSE_TIMEOUT_MS);
+    if (read < 0) {
+        return ESP_FAIL;
+    }
+    if (read < MIN_RESPONSE_SIZE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (response[0] != request[0] || (response[1] & ~EXCEPTION_FLAG) != request[1]) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    size_t len = MIN_RESPONSE_SIZE;
+    if ((response[1] & EXCEPTION_FLAG) == 0 && response_len > MIN_RESPONSE_SIZE) {
+        read = transport->read(transport->ctx, response + len, response_len - len, RESPONSE_TIMEOUT_MS);
+        if (read < 0) {
+            return ESP_FAIL;
+        }
+        if ((size_t)read < response_len - len) {
+            return ESP_ERR_TIMEOUT;
+        }
+        len = response_len;
+    }
+
+    uint16_t crc = modbus_rtu_crc16(response, len - 2);
+    if (response[len - 2] != (crc & 0xFF) || response[len - 1] != (crc >> 8)) {
+        return ESP_ERR_INVALID_CRC;
+    }
+    if (response[1] & EXCEPTION_FLAG) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t modbus_rtu_read_coils(const modbus_transport_t *transport, uint8_t slave, uint16_t start, uint16_t count,
+                                uint32_t *values) {
+    if (count == 0 || count > MODBUS_RTU_MAX_COILS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t request[MODBUS_RTU_MAX_FRAME];
+    uint8_t response[MODBUS_RTU_MAX_FRAME];
+    size_t bytes = coil_bytes(count);
+
+    size_t request_len = modbus_rtu_build_read_coils(request, slave, start, count);
+    esp_err_t err = transact(transport, request, request_len, response, 3 + bytes + 2);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (response[2] != bytes) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint32_t result = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        result |= (uint32_t)response[3 + i] << (8 * i);
+    }
+    *values = count < 32 ? result & ((1UL << count) - 1) : result;
+    return ESP_OK;
+}
+
+esp_err_t modbus_rtu_write_coils(const modbus_transport_t *transport, uint8_t slave, uint16_t start, uint16_t count,
+                                 uint32_t values) {
+    if (count == 0 || count > MODBUS_RTU_MAX_COILS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t request[MODBUS_RTU_MAX_FRAME];
+    uint8_t response[MODBUS_RTU_MAX_FRAME];
+
+    size_t request_len = modbus_rtu_build_write_coils(request, slave, start, count, values);
+    esp_err_t err = transact(transport, request, request_len, response, 8);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // The slave echoes the start address and quantity of the request.
+    for (size_t i = 2; i < 6; i++) {
+        if (response[i] != request[i]) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+    return ESP_OK;
+}
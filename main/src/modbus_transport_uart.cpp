@@ -0,0 +1,95 @@
+#include "modbus_transport.h"
+#include "modbus_rtu.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_BRIDGE_ENABLED
+
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <esp_log.h>
+#include <freertos/task.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+
+#define BRIDGE_UART_PORT ((uart_port_t)CONFIG_APP_BRIDGE_UART_PORT)
+#define BRIDGE_UART_BUFFER_SIZE 256
+#define FRAME_GAP_US MODBUS_RTU_FRAME_GAP_US(CONFIG_APP_BRIDGE_BAUD_RATE)
+
+static const char *TAG = "MODBUS_UART";
+static int64_t last_rx_us = 0;
+
+static void uart_flush_rx(void *ctx) {
+    uart_flush_input(BRIDGE_UART_PORT);
+}
+
+// Waits until the bus has been silent for the frame gap since the last response.
+static void wait_frame_gap(void) {
+    int64_t remaining_us = FRAME_GAP_US - (esp_timer_get_time() - last_rx_us);
+
+    // Whole ticks are slept, which only happens with long gaps or a fast tick rate. vTaskDelay() may return
+    // up to a tick early, so the rest is measured again and waited out exactly.
+    TickType_t ticks = remaining_us > 0 ? (TickType_t)(remaining_us / (portTICK_PERIOD_MS * 1000)) : 0;
+    if (ticks > 0) {
+        vTaskDelay(ticks);
+        remaining_us = FRAME_GAP_US - (esp_timer_get_time() - last_rx_us);
+    }
+    if (remaining_us > 0) {
+        esp_rom_delay_us((uint32_t)remaining_us);
+    }
+}
+
+static esp_err_t uart_write(void *ctx, const uint8_t *data, size_t len) {
+    wait_frame_gap();
+
+    if (uart_write_bytes(BRIDGE_UART_PORT, data, len) != (int)len) {
+        return ESP_FAIL;
+    }
+    // The transceiver must be back in receive mode before the slave starts answering.
+    return uart_wait_tx_done(BRIDGE_UART_PORT, pdMS_TO_TICKS(100));
+}
+
+static int uart_read(void *ctx, uint8_t *data, size_t len, uint32_t timeout_ms) {
+    int read = uart_read_bytes(BRIDGE_UART_PORT, data, len, pdMS_TO_TICKS(timeout_ms));
+    last_rx_us = esp_timer_get_time();
+    return read;
+}
+
+esp_err_t modbus_transport_uart_init(modbus_transport_t *transport) {
+    uart_config_t uart_config = {};
+    uart_config.baud_rate = CONFIG_APP_BRIDGE_BAUD_RATE;
+    uart_config.data_bits = UART_DATA_8_BITS;
+    uart_config.parity = UART_PARITY_DISABLE;
+    uart_config.stop_bits = UART_STOP_BITS_1;
+    uart_config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    uart_config.source_clk = UART_SCLK_DEFAULT;
+
+    esp_err_t err = uart_driver_install(BRIDGE_UART_PORT, BRIDGE_UART_BUFFER_SIZE, BRIDGE_UART_BUFFER_SIZE, 0, NULL, 0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "UART driver install failed: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = uart_param_config(BRIDGE_UART_PORT, &uart_config);
+    if (err == ESP_OK) {
+        err = uart_set_pin(BRIDGE_UART_PORT, CONFIG_APP_BRIDGE_UART_TX_GPIO, CONFIG_APP_BRIDGE_UART_RX_GPIO,
+                           CONFIG_APP_BRIDGE_UART_DE_GPIO, UART_PIN_NO_CHANGE);
+    }
+    if (err == ESP_OK) {
+        err = uart_set_mode(BRIDGE_UART_PORT, UART_MODE_RS485_HALF_DUPLEX);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "UART configuration failed: %s", esp_err_to_name(err));
+        uart_driver_delete(BRIDGE_UART_PORT);
+        return err;
+    }
+
+    transport->flush = uart_flush_rx;
+    transport->write = uart_write;
+    transport->read = uart_read;
+    transport->ctx = NULL;
+
+    ESP_LOGI(TAG, "RS-485 UART%d initialized at %d baud", CONFIG_APP_BRIDGE_UART_PORT, CONFIG_APP_BRIDGE_BAUD_RATE);
+    return ESP_OK;
+}
+
+#endif // CONFIG_APP_BRIDGE_ENABLED
@@ -1,4 +1,5 @@
 #include "relay.h"
+#include "alloc_tracer.h"
 
 #include "driver/gpio.h"
 #include "esp_log.h"
@@ -42,6 +43,8 @@ esp_err_t relay_init(void) {
 }
 
 esp_err_t relay_set(bool state) {
+    AllocTraceScope trace(ALLOC_REGION_RELAY_SET);
+
     esp_err_t gpio_ret = gpio_set_level(RELAY_PIN, relay_gpio_level_for_state(state));
     if (gpio_ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to set relay state: %s", esp_err_to_name(gpio_ret));
@@ -0,0 +1,270 @@
+#include "relay_bridge.h"
+
+#if CONFIG_APP_BRIDGE_ENABLED
+
+#include "matter_interface.h"
+#include "modbus_rtu.h"
+
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_matter.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define MODULE_COUNT CONFIG_APP_BRIDGE_MODULE_COUNT
+#define COILS_PER_MODULE CONFIG_APP_BRIDGE_COILS_PER_MODULE
+#define BRIDGED_RELAY_COUNT (MODULE_COUNT * COILS_PER_MODULE)
+
+// Logging and Matter attribute updates from the poll path need more than the 3 KB the bus code alone would.
+#define BRIDGE_TASK_STACK_SIZE 6144
+// Requests arriving within this window of each other go out in the same bus cycle. The window is at least
+// one tick, 10 ms at the default 100 Hz tick rate.
+#define WRITE_SETTLE_MS 5
+
+static_assert(COILS_PER_MODULE <= MODBUS_RTU_MAX_COILS, "a module's coils must fit in one transaction");
+
+using namespace chip::app::Clusters;
+
+static const char *TAG = "RELAY_BRIDGE";
+
+// Coil states are bit masks, bit n being coil n of the module.
+typedef struct {
+    uint8_t slave;
+    uint32_t actual;   // Last state read from or written to the module, as reported to Matter.
+    uint32_t desired;  // State requested through Matter.
+    uint32_t pending;  // Coils whose desired state has not been written yet.
+    bool online;
+} bridge_module_t;
+
+static modbus_transport_t bus;
+static bridge_module_t modules[MODULE_COUNT];
+static uint16_t endpoint_ids[BRIDGED_RELAY_COUNT];
+static size_t bridged_count = 0;
+static portMUX_TYPE modules_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t bridge_task_handle = NULL;
+static UBaseType_t stack_low_water = BRIDGE_TASK_STACK_SIZE;
+
+// Endpoint IDs are allocated sequentially, so the relay index is an offset from the first one.
+static int relay_index(uint16_t endpoint_id) {
+    uint16_t offset = endpoint_id - endpoint_ids[0];
+    if (offset >= bridged_count || endpoint_ids[offset] != endpoint_id) {
+        return -1;
+    }
+    return offset;
+}
+
+static void report_reachable(const bridge_module_t *module, bool reachable) {
+    size_t first = (module - modules) * COILS_PER_MODULE;
+    esp_matter_attr_val_t val = esp_matter_bool(reachable);
+
+    for (size_t coil = 0; coil < COILS_PER_MODULE; coil++) {
+        esp_matter::attribute::update(endpoint_ids[first + coil], BridgedDeviceBasicInformation::Id,
+                                      BridgedDeviceBasicInformation::Attributes::Reachable::Id, &val);
+    }
+}
+
+static void write_pending(bridge_module_t *module) {
+    taskENTER_CRITICAL(&modules_lock);
+    uint32_t pending = module->pending;
+    uint32_t desired = module->desired;
+    uint32_t actual = module->actual;
+    taskEXIT_CRITICAL(&modules_lock);
+
+    if (pending == 0) {
+        return;
+    }
+
+    // Coils without a pending change are rewritten with their current state so the whole module
+    // goes out in one Write Multiple Coils request.
+    uint32_t values = (actual & ~pending) | (desired & pending);
+    esp_err_t err = modbus_rtu_write_coils(&bus, module->slave, 0, COILS_PER_MODULE, values);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Write to slave %u failed: %s", (unsigned int)module->slave, esp_err_to_name(err));
+        return;
+    }
+
+    taskENTER_CRITICAL(&modules_lock);
+    module->actual = (module->actual & ~pending) | (desired & pending);
+    module->pending &= module->desired ^ module->actual;
+    taskEXIT_CRITICAL(&modules_lock);
+}
+
+static void poll(bridge_module_t *module) {
+    uint32_t values = 0;
+    esp_err_t err = modbus_rtu_read_coils(&bus, module->slave, 0, COILS_PER_MODULE, &values);
+    if (err != ESP_OK) {
+        if (module->online) {
+            ESP_LOGW(TAG, "Slave %u unreachable: %s", (unsigned int)module->slave, esp_err_to_name(err));
+            taskENTER_CRITICAL(&modules_lock);
+            module->online = false;
+            taskEXIT_CRITICAL(&modules_lock);
+            report_reachable(module, false);
+        }
+        return;
+    }
+
+    if (!module->online) {
+        ESP_LOGI(TAG, "Slave %u reachable again", (unsigned int)module->slave);
+        taskENTER_CRITICAL(&modules_lock);
+        module->online = true;
+        taskEXIT_CRITICAL(&modules_lock);
+        report_reachable(module, true);
+    }
+
+    // Coils with a pending write keep their requested state until the write goes out.
+    taskENTER_CRITICAL(&modules_lock);
+    uint32_t changed = (values ^ module->actual) & ~module->pending;
+    module->actual ^= changed;
+    taskEXIT_CRITICAL(&modules_lock);
+
+    size_t first = (module - modules) * COILS_PER_MODULE;
+    while (changed != 0) {
+        int coil = __builtin_ctz(changed);
+        changed &= changed - 1;
+        matter_update_value(endpoint_ids[first + coil], (values >> coil) & 1);
+    }
+}
+
+static void log_stack_low_water(void) {
+    UBaseType_t free_bytes = uxTaskGetStackHighWaterMark(NULL);
+    if (free_bytes < stack_low_water) {
+        stack_low_water = free_bytes;
+        ESP_LOGI(TAG, "Bridge task stack high-water mark: %u of %d bytes free", (unsigned int)free_bytes,
+                 BRIDGE_TASK_STACK_SIZE);
+    }
+}
+
+static void bridge_task(void *pvParameter) {
+    const TickType_t settle_ticks = pdMS_TO_TICKS(WRITE_SETTLE_MS) > 0 ? pdMS_TO_TICKS(WRITE_SETTLE_MS) : 1;
+
+    while (true) {
+        // Once woken by a request, wait until requests stop arriving, so a group command fanned out to
+        // several bridged relays goes out as one write per module whichever core it is issued from.
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_APP_BRIDGE_POLL_INTERVAL_MS)) > 0) {
+            while (ulTaskNotifyTake(pdTRUE, settle_ticks) > 0) {
+            }
+        }
+
+        // Writes go out first so a command reaches the coils before this cycle's reads.
+        for (size_t i = 0; i < MODULE_COUNT; i++) {
+            write_pending(&modules[i]);
+        }
+        for (size_t i = 0; i < MODULE_COUNT; i++) {
+            poll(&modules[i]);
+        }
+
+        log_stack_low_water();
+    }
+}
+
+esp_err_t relay_bridge_init(esp_matter::node_t *matter_node, const modbus_transport_t *transport) {
+    if (matter_node == nullptr || transport == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    bus = *transport;
+
+    esp_matter::endpoint::aggregator::config_t aggregator_config;
+    esp_matter::endpoint_t *aggregator = esp_matter::endpoint::aggregator::create(
+        matter_node, &aggregator_config, esp_matter::ENDPOINT_FLAG_NONE, nullptr);
+    if (aggregator == nullptr) {
+        ESP_LOGE(TAG, "Failed to create aggregator endpoint.");
+        return ESP_FAIL;
+    }
+
+    for (size_t i = 0; i < BRIDGED_RELAY_COUNT; i++) {
+        esp_matter::endpoint::bridged_node::config_t bridged_node_config;
+        esp_matter::endpoint_t *endpoint = esp_matter::endpoint::bridged_node::create(
+            matter_node, &bridged_node_config, esp_matter::ENDPOINT_FLAG_BRIDGE, nullptr);
+        if (endpoint == nullptr) {
+            ESP_LOGE(TAG, "Failed to create bridged endpoint.");
+            return ESP_FAIL;
+        }
+
+        esp_matter::endpoint::on_off_light::config_t on_off_light_config;
+        on_off_light_config.on_off.on_off = false;
+        if (esp_matter::endpoint::on_off_light::add(endpoint, &on_off_light_config) != ESP_OK ||
+            esp_matter::endpoint::set_parent_endpoint(endpoint, aggregator) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to set up bridged endpoint.");
+            return ESP_FAIL;
+        }
+
+        endpoint_ids[i] = esp_matter::endpoint::get_id(endpoint);
+        if (i > 0 && endpoint_ids[i] != endpoint_ids[i - 1] + 1) {
+            ESP_LOGE(TAG, "Bridged endpoint IDs are not contiguous.");
+            return ESP_FAIL;
+        }
+    }
+
+    for (size_t i = 0; i < MODULE_COUNT; i++) {
+        modules[i].slave = CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS + i;
+        modules[i].online = true;
+    }
+    bridged_count = BRIDGED_RELAY_COUNT;
+
+    ESP_LOGI(TAG, "Bridged %d relays on %d modules, endpoints %u-%u", BRIDGED_RELAY_COUNT, MODULE_COUNT,
+             (unsigned int)endpoint_ids[0], (unsigned int)endpoint_ids[BRIDGED_RELAY_COUNT - 1]);
+    return ESP_OK;
+}
+
+esp_err_t relay_bridge_start(void) {
+    if (bridge_task_handle != NULL) {
+        return ESP_OK;
+    }
+
+    BaseType_t created = xTaskCreate(bridge_task, "bridge_task", BRIDGE_TASK_STACK_SIZE, NULL, 3,
+                                     &bridge_task_handle);
+    if (created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create bridge task");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+bool relay_bridge_owns_endpoint(uint16_t endpoint_id) {
+    return relay_index(endpoint_id) >= 0;
+}
+
+esp_err_t relay_bridge_set(uint16_t endpoint_id, bool state) {
+    int index = relay_index(endpoint_id);
+    if (index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    bridge_module_t *module = &modules[index / COILS_PER_MODULE];
+    uint32_t bit = 1UL << (index % COILS_PER_MODULE);
+
+    // An unreachable module would keep the request pending while the attribute already shows it; rejecting
+    // it fails the attribute write instead, so the controller sees the relay did not switch.
+    taskENTER_CRITICAL(&modules_lock);
+    if (!module->online) {
+        taskEXIT_CRITICAL(&modules_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    module->desired = state ? module->desired | bit : module->desired & ~bit;
+    module->pending = (module->pending & ~bit) | ((module->desired ^ module->actual) & bit);
+    bool wake = (module->pending & bit) != 0;
+    taskEXIT_CRITICAL(&modules_lock);
+
+    if (wake && bridge_task_handle != NULL) {
+        xTaskNotifyGive(bridge_task_handle);
+    }
+    return ESP_OK;
+}
+
+bool relay_bridge_get(uint16_t endpoint_id) {
+    int index = relay_index(endpoint_id);
+    if (index < 0) {
+        return false;
+    }
+
+    bridge_module_t *module = &modules[index / COILS_PER_MODULE];
+    uint32_t bit = 1UL << (index % COILS_PER_MODULE);
+
+    taskENTER_CRITICAL(&modules_lock);
+    uint32_t state = (module->pending & bit) ? module->desired : module->actual;
+    taskEXIT_CRITICAL(&modules_lock);
+
+    return (state & bit) != 0;
+}
+
+#endif // CONFIG_APP_BRIDGE_ENABLED
@@ -0,0 +1,263 @@
+#include "relay_groups.h"
+#include "matter_interface.h"
+
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+#include <access/AccessControl.h>
+#include <app/CommandHandlerInterface.h>
+#include <app/CommandHandlerInterfaceRegistry.h>
+#include <app/server/Server.h>
+#include <credentials/GroupDataProvider.h>
+#include <messaging/ExchangeContext.h>
+#include <platform/PlatformManager.h>
+
+#include <inttypes.h>
+#include "sdkconfig.h"
+
+#if CONFIG_APP_BRIDGE_ENABLED
+#define RELAY_COUNT (1 + CONFIG_APP_BRIDGE_MODULE_COUNT * CONFIG_APP_BRIDGE_COILS_PER_MODULE)
+#else
+#define RELAY_COUNT 1
+#endif
+
+// The local relay and every bridged relay, each in up to CONFIG_APP_GROUPS_PER_RELAY groups.
+#define MAX_GROUP_ENTRIES (RELAY_COUNT * CONFIG_APP_GROUPS_PER_RELAY)
+
+using chip::app::CommandHandlerInterface;
+using chip::app::CommandHandlerInterfaceRegistry;
+using chip::Credentials::GroupDataProvider;
+using namespace chip::app::Clusters;
+
+static const char *TAG = "RELAY_GROUPS";
+
+typedef struct {
+    chip::FabricIndex fabric_index;
+    chip::GroupId group_id;
+    chip::EndpointId endpoint_id;
+} group_entry_t;
+
+// Identifies a group message. The CommandHandler is pooled and reused, but every message opens a new
+// exchange, whose ID the sender never reuses for the next one.
+typedef struct {
+    chip::FabricIndex fabric_index;
+    chip::GroupId group_id;
+    chip::NodeId source_node_id;
+    uint16_t exchange_id;
+} group_message_t;
+
+// Sorted by (fabric_index, group_id) so that all members of a group are contiguous.
+static group_entry_t group_index[MAX_GROUP_ENTRIES];
+static size_t group_index_count = 0;
+static bool group_index_stale = true;
+
+// Message whose member relays have been switched. Its remaining dispatches leave the relays alone; the
+// state is cleared once the Matter task has finished processing the message.
+static bool fanout_active = false;
+static group_message_t fanout_message;
+
+static bool entry_less(const group_entry_t &a, chip::FabricIndex fabric_index, chip::GroupId group_id) {
+    return a.fabric_index < fabric_index || (a.fabric_index == fabric_index && a.group_id < group_id);
+}
+
+static bool entry_after(const group_entry_t &a, chip::FabricIndex fabric_index, chip::GroupId group_id) {
+    return a.fabric_index > fabric_index || (a.fabric_index == fabric_index && a.group_id > group_id);
+}
+
+static void group_index_rebuild(void) {
+    GroupDataProvider *provider = chip::Credentials::GetGroupDataProvider();
+    group_index_count = 0;
+    size_t dropped = 0;
+
+    for (const chip::FabricInfo &fabric : chip::Server::GetInstance().GetFabricTable()) {
+        GroupDataProvider::EndpointIterator *it = provider->IterateEndpoints(fabric.GetFabricIndex());
+        if (it == nullptr) {
+            continue;
+        }
+
+        GroupDataProvider::GroupEndpoint mapping;
+        while (it->Next(mapping)) {
+            if (!matter_is_relay_endpoint(mapping.endpoint_id)) {
+                continue;
+            }
+            if (group_index_count == MAX_GROUP_ENTRIES) {
+                dropped++;
+                continue;
+            }
+
+            // Insertion sort keeps the table ordered; it only runs when membership changes.
+            size_t pos = group_index_count++;
+            while (pos > 0 && entry_after(group_index[pos - 1], fabric.GetFabricIndex(), mapping.group_id)) {
+                group_index[pos] = group_index[pos - 1];
+                pos--;
+            }
+            group_index[pos] = {fabric.GetFabricIndex(), mapping.group_id, mapping.endpoint_id};
+        }
+        it->Release();
+    }
+
+    group_index_stale = false;
+    if (dropped > 0) {
+        // Those relays are still switched, by their own dispatch of each group command.
+        ESP_LOGE(TAG, "Group index full: %u relay memberships left out, raise CONFIG_APP_GROUPS_PER_RELAY above %d",
+                 (unsigned int)dropped, CONFIG_APP_GROUPS_PER_RELAY);
+    }
+    ESP_LOGI(TAG, "Group index rebuilt with %u relay memberships", (unsigned int)group_index_count);
+}
+
+// Returns the first entry of the group and stores the member count in count.
+static const group_entry_t *group_index_find(chip::FabricIndex fabric_index, chip::GroupId group_id, size_t *count) {
+    if (group_index_stale) {
+        group_index_rebuild();
+    }
+
+    size_t low = 0;
+    size_t high = group_index_count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (entry_less(group_index[mid], fabric_index, group_id)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    size_t end = low;
+    while (end < group_index_count && group_index[end].fabric_index == fabric_index &&
+           group_index[end].group_id == group_id) {
+        end++;
+    }
+
+    *count = end - low;
+    return &group_index[low];
+}
+
+static bool same_message(const group_message_t &a, const group_message_t &b) {
+    return a.fabric_index == b.fabric_index && a.group_id == b.group_id && a.source_node_id == b.source_node_id &&
+           a.exchange_id == b.exchange_id;
+}
+
+// The Matter stack only dispatches a group command to endpoints where the group holds Operate privilege,
+// so the fan-out applies the same check.
+static bool operate_allowed(const chip::Access::SubjectDescriptor &subject, chip::EndpointId endpoint_id) {
+    chip::Access::RequestPath path;
+    path.cluster = OnOff::Id;
+    path.endpoint = endpoint_id;
+    path.requestType = chip::Access::RequestType::kCommandInvokeRequest;
+    return chip::Access::GetAccessControl().Check(subject, path, chip::Access::Privilege::kOperate) == CHIP_NO_ERROR;
+}
+
+static void group_fanout(chip::CommandId command_id, const chip::Access::SubjectDescriptor &subject,
+                         const group_entry_t *members, size_t count, chip::GroupId group_id) {
+    int64_t first_us = 0;
+    int64_t last_us = 0;
+    size_t switched = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!operate_allowed(subject, members[i].endpoint_id)) {
+            continue;
+        }
+
+        bool state;
+        if (command_id == OnOff::Commands::On::Id) {
+            state = true;
+        } else if (command_id == OnOff::Commands::Off::Id) {
+            state = false;
+        } else {
+            state = !matter_relay_get(members[i].endpoint_id);
+        }
+
+        esp_err_t err = matter_relay_set(members[i].endpoint_id, state);
+        last_us = esp_timer_get_time();
+        if (switched++ == 0) {
+            first_us = last_us;
+        }
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to switch endpoint %u for group 0x%04x", (unsigned int)members[i].endpoint_id,
+                     (unsigned int)group_id);
+        }
+    }
+
+    ESP_LOGD(TAG, "Group 0x%04x switched %u relays, actuation spread %" PRId64 " us", (unsigned int)group_id,
+             (unsigned int)switched, last_us - first_us);
+}
+
+static void fanout_clear(intptr_t arg) {
+    fanout_active = false;
+}
+
+class OnOffGroupHandler : public CommandHandlerInterface {
+public:
+    OnOffGroupHandler() : CommandHandlerInterface(chip::NullOptional, OnOff::Id) {}
+
+    // Only switches the hardware; the command is left unhandled so the OnOff server still updates
+    // the attribute of every member endpoint, whose callbacks then find the relay already in place.
+    // All dispatches of a message run back to back on the Matter task, so the first one switches every
+    // member and the others only let the attribute update through.
+    void InvokeCommand(HandlerContext &handlerContext) override {
+        chip::CommandId command_id = handlerContext.mRequestPath.mCommandId;
+        if (command_id != OnOff::Commands::On::Id && command_id != OnOff::Commands::Off::Id &&
+            command_id != OnOff::Commands::Toggle::Id) {
+            return;
+        }
+
+        chip::Access::SubjectDescriptor subject = handlerContext.mCommandHandler.GetSubjectDescriptor();
+        chip::Messaging::ExchangeContext *exchange = handlerContext.mCommandHandler.GetExchangeContext();
+        if (subject.authMode != chip::Access::AuthMode::kGroup || exchange == nullptr) {
+            return;
+        }
+
+        group_message_t message = {subject.fabricIndex, chip::GroupIdFromNodeId(subject.subject),
+                                   exchange->GetSessionHandle()->GetPeer().GetNodeId(), exchange->GetExchangeId()};
+        if (fanout_active && same_message(message, fanout_message)) {
+            return;
+        }
+
+        size_t count = 0;
+        const group_entry_t *members = group_index_find(message.fabric_index, message.group_id, &count);
+        if (count == 0) {
+            return;
+        }
+
+        // Runs after the remaining dispatches of this message.
+        fanout_active = chip::DeviceLayer::PlatformMgr().ScheduleWork(fanout_clear, 0) == CHIP_NO_ERROR;
+        fanout_message = message;
+        group_fanout(command_id, subject, members, count, message.group_id);
+    }
+};
+
+class GroupsMembershipHandler : public CommandHandlerInterface {
+public:
+    GroupsMembershipHandler() : CommandHandlerInterface(chip::NullOptional, Groups::Id) {}
+
+    // Any Groups command may change membership; the Groups server still executes it.
+    void InvokeCommand(HandlerContext &handlerContext) override {
+        relay_groups_invalidate();
+    }
+};
+
+static OnOffGroupHandler on_off_group_handler;
+static GroupsMembershipHandler groups_membership_handler;
+
+static void register_handlers(intptr_t arg) {
+    CommandHandlerInterfaceRegistry &registry = CommandHandlerInterfaceRegistry::Instance();
+    if (registry.RegisterCommandHandler(&on_off_group_handler) != CHIP_NO_ERROR ||
+        registry.RegisterCommandHandler(&groups_membership_handler) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to register group command handlers");
+        return;
+    }
+    ESP_LOGI(TAG, "Group command handlers registered");
+}
+
+esp_err_t relay_groups_init(void) {
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(register_handlers, 0) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to schedule group handler registration");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void relay_groups_invalidate(void) {
+    group_index_stale = true;
+}
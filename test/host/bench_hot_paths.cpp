@@ -0,0 +1,131 @@
+// Checks and times the relay and LED hot paths: attribute callback dispatch, relay switching, LED mode
+// switching and rendering. Run it before and after a change to these paths and compare the ns/op.
+
+#include "host_test.h"
+#include "host_fakes.h"
+
+#include "events.h"
+#include "matter_interface.h"
+#include "relay.h"
+#include "rgb_led.h"
+#include "rgb_led_modes.h"
+
+#include <esp_matter.h>
+
+#define ITERATIONS 200000
+#define RELAY_PIN GPIO_NUM_22
+
+using esp_matter::attribute::callback_type_t;
+using namespace chip::app::Clusters;
+
+static uint16_t relay_endpoint_id;
+
+static esp_err_t on_off_callback(callback_type_t type, uint16_t endpoint_id, bool state) {
+    esp_matter_attr_val_t val = esp_matter_bool(state);
+    return matter_attribute_update_callback(type, endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val,
+                                            nullptr);
+}
+
+static void check_relay_path(void) {
+    HOST_CHECK(on_off_callback(callback_type_t::PRE_UPDATE, relay_endpoint_id, true) == ESP_OK);
+    HOST_CHECK(relay_get());
+    HOST_CHECK(gpio_get_level(RELAY_PIN) == 1);
+
+    HOST_CHECK(matter_update_value(relay_endpoint_id, false) == ESP_OK);
+    HOST_CHECK(!relay_get());
+    HOST_CHECK(gpio_get_level(RELAY_PIN) == 0);
+
+    esp_matter_attr_val_t val;
+    HOST_CHECK(fake_esp_matter_get(relay_endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val) == ESP_OK);
+    HOST_CHECK(val.type == ESP_MATTER_VAL_TYPE_BOOLEAN && !val.val.b);
+
+    // POST_UPDATE and other endpoints leave the relay alone.
+    HOST_CHECK(on_off_callback(callback_type_t::POST_UPDATE, relay_endpoint_id, true) == ESP_OK);
+    HOST_CHECK(on_off_callback(callback_type_t::PRE_UPDATE, relay_endpoint_id + 1, true) == ESP_OK);
+    HOST_CHECK(!relay_get());
+}
+
+static void check_rgb_path(void) {
+    led_strip_config_t strip_config = {.strip_gpio_num = 8, .max_leds = 1};
+    led_strip_rmt_config_t rmt_config = {.resolution_hz = 10 * 1000 * 1000};
+    led_strip_handle_t strip = nullptr;
+    HOST_CHECK(led_strip_new_rmt_device(&strip_config, &rmt_config, &strip) == ESP_OK);
+
+    rgb_mode_success(strip);
+    fake_pixel_t pixel = fake_led_strip_shown(strip);
+    HOST_CHECK(pixel.red == 0 && pixel.green == 255 && pixel.blue == 0);
+
+    // The render task draws the current mode once per iteration.
+    TaskHandle_t rgb_task = fake_task_find("rgb_task");
+    HOST_CHECK(rgb_task != nullptr);
+    set_rgb_mode(rgb_mode_fail);
+    fake_task_run(rgb_task, 3);
+    set_rgb_mode(nullptr);
+    fake_task_run(rgb_task, 1);
+}
+
+static void bench_dispatch(void) {
+    host_bench("callback: OnOff PRE_UPDATE, relay endpoint", ITERATIONS, [](uint32_t i) {
+        host_bench_keep(on_off_callback(callback_type_t::PRE_UPDATE, relay_endpoint_id, i & 1));
+    });
+    host_bench("callback: OnOff POST_UPDATE", ITERATIONS, [](uint32_t i) {
+        host_bench_keep(on_off_callback(callback_type_t::POST_UPDATE, relay_endpoint_id, i & 1));
+    });
+    host_bench("callback: OnOff PRE_UPDATE, other endpoint", ITERATIONS, [](uint32_t i) {
+        host_bench_keep(on_off_callback(callback_type_t::PRE_UPDATE, relay_endpoint_id + 1, i & 1));
+    });
+    host_bench("callback: unhandled attribute", ITERATIONS, [](uint32_t i) {
+        esp_matter_attr_val_t val = esp_matter_uint8(i);
+        host_bench_keep(matter_attribute_update_callback(callback_type_t::PRE_UPDATE, relay_endpoint_id,
+                                                         Groups::Id, 0, &val, nullptr));
+    });
+    host_bench("matter_update_value, PRE and POST_UPDATE", ITERATIONS, [](uint32_t i) {
+        host_bench_keep(matter_update_value(relay_endpoint_id, i & 1));
+    });
+}
+
+static void bench_relay(void) {
+    host_bench("relay_set", ITERATIONS, [](uint32_t i) { host_bench_keep(relay_set(i & 1)); });
+    host_bench("relay_get", ITERATIONS, [](uint32_t i) { host_bench_keep(relay_get()); });
+    host_bench("matter_relay_set, local relay", ITERATIONS, [](uint32_t i) {
+        host_bench_keep(matter_relay_set(relay_endpoint_id, i & 1));
+    });
+}
+
+static void bench_rgb(void) {
+    static const rgb_mode_fn modes[] = {rgb_mode_red_blink, rgb_mode_success, rgb_mode_fail,
+                                        rgb_mode_commissioning_in_progress, nullptr};
+    host_bench("set_rgb_mode", ITERATIONS, [](uint32_t i) { set_rgb_mode(modes[i % 5]); });
+
+    led_strip_config_t strip_config = {.strip_gpio_num = 8, .max_leds = 1};
+    led_strip_rmt_config_t rmt_config = {.resolution_hz = 10 * 1000 * 1000};
+    static led_strip_handle_t strip = nullptr;
+    led_strip_new_rmt_device(&strip_config, &rmt_config, &strip);
+
+    host_bench("render: rgb_mode_red_blink", ITERATIONS, [](uint32_t i) { rgb_mode_red_blink(strip); });
+    host_bench("render: rgb_mode_commissioning_in_progress", ITERATIONS,
+               [](uint32_t i) { rgb_mode_commissioning_in_progress(strip); });
+
+    // One call runs the whole render loop, so it is timed per loop iteration.
+    TaskHandle_t rgb_task = fake_task_find("rgb_task");
+    set_rgb_mode(rgb_mode_red_blink);
+    host_bench("render: rgb_task, 1000 loop iterations", ITERATIONS / 1000, [rgb_task](uint32_t i) {
+        fake_task_run(rgb_task, 1000);
+    });
+    set_rgb_mode(nullptr);
+}
+
+int main(void) {
+    HOST_CHECK(relay_init() == ESP_OK);
+    HOST_CHECK(rgb_led_init() == ESP_OK);
+    HOST_CHECK(matter_init(&relay_endpoint_id) == ESP_OK);
+
+    check_relay_path();
+    check_rgb_path();
+
+    bench_dispatch();
+    bench_relay();
+    bench_rgb();
+
+    return host_test_result();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Access control that grants every request except those denied with fake_access_deny().
+
+#include <access/SubjectDescriptor.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+
+namespace chip {
+namespace Access {
+
+enum class Privilege : uint8_t {
+    kView = 1 << 0,
+    kProxyView = 1 << 1,
+    kOperate = 1 << 2,
+    kManage = 1 << 3,
+    kAdminister = 1 << 4,
+};
+
+enum class RequestType : uint8_t {
+    kRequestTypeUnknown,
+    kAttributeReadRequest,
+    kAttributeWriteRequest,
+    kCommandInvokeRequest,
+    kEventReadRequest,
+};
+
+struct RequestPath {
+    ClusterId cluster = 0;
+    EndpointId endpoint = 0;
+    RequestType requestType = RequestType::kRequestTypeUnknown;
+};
+
+class AccessControl {
+public:
+    CHIP_ERROR Check(const SubjectDescriptor &subjectDescriptor, const RequestPath &requestPath,
+                     Privilege requestPrivilege);
+};
+
+AccessControl &GetAccessControl();
+
+} // namespace Access
+} // namespace chip
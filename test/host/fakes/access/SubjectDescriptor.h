@@ -0,0 +1,22 @@
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+namespace chip {
+namespace Access {
+
+enum class AuthMode : uint8_t {
+    kNone = 0,
+    kPase = 1,
+    kCase = 2,
+    kGroup = 3,
+};
+
+struct SubjectDescriptor {
+    FabricIndex fabricIndex = kUndefinedFabricIndex;
+    AuthMode authMode = AuthMode::kNone;
+    NodeId subject = 0;
+};
+
+} // namespace Access
+} // namespace chip
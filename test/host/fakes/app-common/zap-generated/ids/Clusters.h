@@ -0,0 +1,49 @@
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+// Cluster, attribute and command IDs used by the application.
+namespace chip {
+namespace app {
+namespace Clusters {
+
+namespace Groups {
+static constexpr ClusterId Id = 0x0004;
+} // namespace Groups
+
+namespace OnOff {
+static constexpr ClusterId Id = 0x0006;
+namespace Attributes {
+namespace OnOff {
+static constexpr AttributeId Id = 0x0000;
+} // namespace OnOff
+} // namespace Attributes
+namespace Commands {
+namespace Off {
+static constexpr CommandId Id = 0x00;
+} // namespace Off
+namespace On {
+static constexpr CommandId Id = 0x01;
+} // namespace On
+namespace Toggle {
+static constexpr CommandId Id = 0x02;
+} // namespace Toggle
+} // namespace Commands
+} // namespace OnOff
+
+namespace DiagnosticLogs {
+static constexpr ClusterId Id = 0x0032;
+} // namespace DiagnosticLogs
+
+namespace BridgedDeviceBasicInformation {
+static constexpr ClusterId Id = 0x0039;
+namespace Attributes {
+namespace Reachable {
+static constexpr AttributeId Id = 0x0011;
+} // namespace Reachable
+} // namespace Attributes
+} // namespace BridgedDeviceBasicInformation
+
+} // namespace Clusters
+} // namespace app
+} // namespace chip
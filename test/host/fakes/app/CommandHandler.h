@@ -0,0 +1,20 @@
+#pragma once
+
+#include <access/SubjectDescriptor.h>
+#include <messaging/ExchangeContext.h>
+
+namespace chip {
+namespace app {
+
+// Per-message command handler state. Like the real one, it lives in a pool and is reused across messages.
+class CommandHandler {
+public:
+    Access::SubjectDescriptor GetSubjectDescriptor() const { return subject; }
+    Messaging::ExchangeContext *GetExchangeContext() const { return exchange; }
+
+    Access::SubjectDescriptor subject;
+    Messaging::ExchangeContext *exchange = nullptr;
+};
+
+} // namespace app
+} // namespace chip
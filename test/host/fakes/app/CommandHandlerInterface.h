@@ -0,0 +1,51 @@
+#pragma once
+
+#include <app/CommandHandler.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/NodeId.h>
+#include <lib/core/Optional.h>
+
+namespace chip {
+namespace app {
+
+struct ConcreteCommandPath {
+    EndpointId mEndpointId;
+    ClusterId mClusterId;
+    CommandId mCommandId;
+};
+
+class CommandHandlerInterface {
+public:
+    struct HandlerContext {
+        HandlerContext(CommandHandler &commandHandler, const ConcreteCommandPath &requestPath)
+            : mCommandHandler(commandHandler), mRequestPath(requestPath) {}
+
+        void SetCommandHandled() { mCommandHandled = true; }
+
+        CommandHandler &mCommandHandler;
+        const ConcreteCommandPath &mRequestPath;
+        bool mCommandHandled = false;
+    };
+
+    CommandHandlerInterface(Optional<EndpointId> endpointId, ClusterId clusterId)
+        : mEndpointId(endpointId), mClusterId(clusterId) {}
+    virtual ~CommandHandlerInterface() = default;
+
+    virtual void InvokeCommand(HandlerContext &handlerContext) = 0;
+
+    bool Matches(EndpointId endpointId, ClusterId clusterId) const {
+        return (!mEndpointId.HasValue() || mEndpointId.Value() == endpointId) && mClusterId == clusterId;
+    }
+
+    CommandHandlerInterface *GetNext() const { return mNext; }
+    void SetNext(CommandHandlerInterface *next) { mNext = next; }
+
+private:
+    Optional<EndpointId> mEndpointId;
+    ClusterId mClusterId;
+    CommandHandlerInterface *mNext = nullptr;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <app/CommandHandlerInterface.h>
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace app {
+
+class CommandHandlerInterfaceRegistry {
+public:
+    static CommandHandlerInterfaceRegistry &Instance();
+
+    CHIP_ERROR RegisterCommandHandler(CommandHandlerInterface *handler);
+    CommandHandlerInterface *GetCommandHandler(EndpointId endpointId, ClusterId clusterId);
+
+private:
+    CommandHandlerInterface *mHandlerList = nullptr;
+};
+
+} // namespace app
+} // namespace chip
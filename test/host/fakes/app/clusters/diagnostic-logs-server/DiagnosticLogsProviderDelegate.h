@@ -0,0 +1,42 @@
+#pragma once
+
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <lib/support/Span.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace DiagnosticLogs {
+
+enum class IntentEnum : uint8_t {
+    kEndUserSupport = 0x00,
+    kNetworkDiag = 0x01,
+    kCrashLogs = 0x02,
+};
+
+typedef uint16_t LogSessionHandle;
+
+constexpr LogSessionHandle kInvalidLogSessionHandle = UINT16_MAX;
+
+class DiagnosticLogsProviderDelegate {
+public:
+    virtual ~DiagnosticLogsProviderDelegate() = default;
+
+    virtual CHIP_ERROR StartLogCollection(IntentEnum intent, LogSessionHandle &outHandle,
+                                          Optional<uint64_t> &outTimeStamp, Optional<uint64_t> &outTimeSinceBoot) = 0;
+    virtual CHIP_ERROR CollectLog(LogSessionHandle sessionHandle, MutableByteSpan &outBuffer,
+                                  bool &outIsEndOfLog) = 0;
+    virtual CHIP_ERROR EndLogCollection(LogSessionHandle sessionHandle) = 0;
+    virtual size_t GetSizeForIntent(IntentEnum intent) = 0;
+    virtual CHIP_ERROR GetLogForIntent(IntentEnum intent, MutableByteSpan &outBuffer,
+                                       Optional<uint64_t> &outTimeStamp, Optional<uint64_t> &outTimeSinceBoot) = 0;
+};
+
+} // namespace DiagnosticLogs
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <stddef.h>
+
+namespace chip {
+
+class FabricInfo {
+public:
+    FabricIndex GetFabricIndex() const { return fabric_index; }
+
+    FabricIndex fabric_index = kUndefinedFabricIndex;
+};
+
+class FabricTable {
+public:
+    static constexpr size_t kMaxFabrics = 5;
+
+    const FabricInfo *begin() const { return fabrics; }
+    const FabricInfo *end() const { return fabrics + count; }
+
+    FabricInfo fabrics[kMaxFabrics];
+    size_t count = 0;
+};
+
+class Server {
+public:
+    static Server &GetInstance();
+
+    FabricTable &GetFabricTable() { return fabric_table; }
+
+private:
+    FabricTable fabric_table;
+};
+
+} // namespace chip
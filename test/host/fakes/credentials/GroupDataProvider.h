@@ -0,0 +1,35 @@
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace Credentials {
+
+class GroupDataProvider {
+public:
+    struct GroupEndpoint {
+        GroupId group_id = 0;
+        EndpointId endpoint_id = 0;
+    };
+
+    template <typename T>
+    class Iterator {
+    public:
+        virtual ~Iterator() = default;
+        virtual size_t Count() = 0;
+        virtual bool Next(T &item) = 0;
+        virtual void Release() = 0;
+    };
+
+    using EndpointIterator = Iterator<GroupEndpoint>;
+
+    virtual ~GroupDataProvider() = default;
+    virtual EndpointIterator *IterateEndpoints(FabricIndex fabric_index) = 0;
+};
+
+GroupDataProvider *GetGroupDataProvider();
+
+} // namespace Credentials
+} // namespace chip
@@ -0,0 +1,146 @@
+#pragma once
+
+// The subset of the esp-matter data model API used by the application. Attributes live in a fixed table;
+// attribute::update() runs the node's attribute callback around the write, like esp-matter does.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <lib/core/DataModelTypes.h>
+#include <platform/CHIPDeviceEvent.h>
+
+#include "esp_err.h"
+
+typedef enum {
+    ESP_MATTER_VAL_TYPE_INVALID = 0,
+    ESP_MATTER_VAL_TYPE_BOOLEAN,
+    ESP_MATTER_VAL_TYPE_INTEGER,
+    ESP_MATTER_VAL_TYPE_FLOAT,
+    ESP_MATTER_VAL_TYPE_UINT8,
+    ESP_MATTER_VAL_TYPE_UINT16,
+    ESP_MATTER_VAL_TYPE_UINT32,
+    ESP_MATTER_VAL_TYPE_ENUM8,
+} esp_matter_val_type_t;
+
+typedef union {
+    bool b;
+    int i;
+    float f;
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+} esp_matter_val_t;
+
+typedef struct {
+    esp_matter_val_type_t type;
+    esp_matter_val_t val;
+} esp_matter_attr_val_t;
+
+esp_matter_attr_val_t esp_matter_bool(bool val);
+esp_matter_attr_val_t esp_matter_uint8(uint8_t val);
+
+namespace esp_matter {
+
+typedef struct fake_node node_t;
+typedef struct fake_endpoint endpoint_t;
+typedef struct fake_cluster cluster_t;
+
+enum endpoint_flags {
+    ENDPOINT_FLAG_NONE = 0x00,
+    ENDPOINT_FLAG_DESTROYABLE = 0x01,
+    ENDPOINT_FLAG_BRIDGE = 0x02,
+};
+
+enum cluster_flags {
+    CLUSTER_FLAG_NONE = 0x00,
+    CLUSTER_FLAG_SERVER = 0x10,
+    CLUSTER_FLAG_CLIENT = 0x20,
+};
+
+typedef void (*event_callback_t)(const ChipDeviceEvent *event, intptr_t arg);
+
+namespace attribute {
+typedef enum callback_type {
+    PRE_UPDATE,
+    POST_UPDATE,
+    READ,
+    WRITE,
+} callback_type_t;
+
+typedef esp_err_t (*callback_t)(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data);
+
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+} // namespace attribute
+
+namespace identification {
+typedef enum callback_type {
+    START,
+    STOP,
+    EFFECT,
+} callback_type_t;
+
+typedef esp_err_t (*callback_t)(callback_type_t type, uint16_t endpoint_id, uint8_t effect_id,
+                                uint8_t effect_variant, void *priv_data);
+} // namespace identification
+
+namespace node {
+typedef struct config {
+} config_t;
+
+node_t *create(config_t *config, attribute::callback_t attribute_callback,
+               identification::callback_t identification_callback, void *priv_data = nullptr);
+} // namespace node
+
+namespace endpoint {
+endpoint_t *get(node_t *node, uint16_t endpoint_id);
+uint16_t get_id(endpoint_t *endpoint);
+esp_err_t set_parent_endpoint(endpoint_t *endpoint, endpoint_t *parent_endpoint);
+
+namespace on_off_light {
+typedef struct config {
+    struct {
+        bool on_off = false;
+    } on_off;
+} config_t;
+
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data);
+esp_err_t add(endpoint_t *endpoint, config_t *config);
+} // namespace on_off_light
+
+namespace aggregator {
+typedef struct config {
+} config_t;
+
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data);
+} // namespace aggregator
+
+namespace bridged_node {
+typedef struct config {
+} config_t;
+
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data);
+} // namespace bridged_node
+} // namespace endpoint
+
+namespace cluster {
+namespace binding {
+typedef struct config {
+} config_t;
+
+cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags);
+} // namespace binding
+
+namespace diagnostic_logs {
+typedef struct config {
+    void *delegate = nullptr;
+} config_t;
+
+cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags);
+} // namespace diagnostic_logs
+} // namespace cluster
+
+esp_err_t start(event_callback_t callback, intptr_t callback_arg = 0);
+
+} // namespace esp_matter
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "esp_err.h"
+
+namespace esp_matter {
+namespace console {
+
+typedef esp_err_t (*command_handler_t)(int argc, char **argv);
+
+typedef struct {
+    const char *name;
+    const char *description;
+    command_handler_t handler;
+} command_t;
+
+esp_err_t add_commands(const command_t *commands, int count);
+esp_err_t diagnostics_register_commands(void);
+esp_err_t wifi_register_commands(void);
+esp_err_t init(void);
+
+} // namespace console
+} // namespace esp_matter
@@ -0,0 +1,271 @@
+#include "host_fakes.h"
+
+#include <access/AccessControl.h>
+#include <app/CommandHandlerInterface.h>
+#include <app/CommandHandlerInterfaceRegistry.h>
+#include <app/server/Server.h>
+#include <credentials/GroupDataProvider.h>
+#include <platform/PlatformManager.h>
+
+#include "esp_matter.h"
+
+#define MAX_GROUP_ENTRIES 128
+#define MAX_DENIED_ENDPOINTS 8
+#define MAX_WORK 16
+
+using chip::Credentials::GroupDataProvider;
+using namespace chip::app::Clusters;
+
+// Command handler registry
+
+namespace chip {
+namespace app {
+
+CommandHandlerInterfaceRegistry &CommandHandlerInterfaceRegistry::Instance() {
+    static CommandHandlerInterfaceRegistry registry;
+    return registry;
+}
+
+CHIP_ERROR CommandHandlerInterfaceRegistry::RegisterCommandHandler(CommandHandlerInterface *handler) {
+    if (handler == nullptr) {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    for (CommandHandlerInterface *cur = mHandlerList; cur != nullptr; cur = cur->GetNext()) {
+        if (cur == handler) {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+    }
+    handler->SetNext(mHandlerList);
+    mHandlerList = handler;
+    return CHIP_NO_ERROR;
+}
+
+CommandHandlerInterface *CommandHandlerInterfaceRegistry::GetCommandHandler(EndpointId endpointId,
+                                                                            ClusterId clusterId) {
+    for (CommandHandlerInterface *cur = mHandlerList; cur != nullptr; cur = cur->GetNext()) {
+        if (cur->Matches(endpointId, clusterId)) {
+            return cur;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace app
+} // namespace chip
+
+// Access control
+
+static chip::EndpointId denied_endpoints[MAX_DENIED_ENDPOINTS];
+static size_t denied_count = 0;
+
+void fake_access_deny(chip::EndpointId endpoint_id) {
+    if (denied_count < MAX_DENIED_ENDPOINTS) {
+        denied_endpoints[denied_count++] = endpoint_id;
+    }
+}
+
+namespace chip {
+namespace Access {
+
+CHIP_ERROR AccessControl::Check(const SubjectDescriptor &subjectDescriptor, const RequestPath &requestPath,
+                                Privilege requestPrivilege) {
+    if (subjectDescriptor.authMode == AuthMode::kGroup) {
+        for (size_t i = 0; i < denied_count; i++) {
+            if (denied_endpoints[i] == requestPath.endpoint) {
+                return CHIP_ERROR_ACCESS_DENIED;
+            }
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+AccessControl &GetAccessControl() {
+    static AccessControl access_control;
+    return access_control;
+}
+
+} // namespace Access
+} // namespace chip
+
+// Fabrics and groups
+
+typedef struct {
+    chip::FabricIndex fabric_index;
+    GroupDataProvider::GroupEndpoint mapping;
+} group_entry_t;
+
+static group_entry_t group_entries[MAX_GROUP_ENTRIES];
+static size_t group_entry_count = 0;
+
+class FakeEndpointIterator : public GroupDataProvider::EndpointIterator {
+public:
+    void Reset(chip::FabricIndex fabric) {
+        fabric_index = fabric;
+        next = 0;
+    }
+
+    size_t Count() override {
+        size_t count = 0;
+        for (size_t i = 0; i < group_entry_count; i++) {
+            count += group_entries[i].fabric_index == fabric_index;
+        }
+        return count;
+    }
+
+    bool Next(GroupDataProvider::GroupEndpoint &item) override {
+        while (next < group_entry_count) {
+            const group_entry_t &entry = group_entries[next++];
+            if (entry.fabric_index == fabric_index) {
+                item = entry.mapping;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Release() override {}
+
+private:
+    chip::FabricIndex fabric_index = chip::kUndefinedFabricIndex;
+    size_t next = 0;
+};
+
+class FakeGroupDataProvider : public GroupDataProvider {
+public:
+    EndpointIterator *IterateEndpoints(chip::FabricIndex fabric_index) override {
+        iterator.Reset(fabric_index);
+        return &iterator;
+    }
+
+private:
+    FakeEndpointIterator iterator;
+};
+
+GroupDataProvider *chip::Credentials::GetGroupDataProvider() {
+    static FakeGroupDataProvider provider;
+    return &provider;
+}
+
+chip::Server &chip::Server::GetInstance() {
+    static Server server;
+    return server;
+}
+
+void fake_fabric_add(chip::FabricIndex fabric_index) {
+    chip::FabricTable &table = chip::Server::GetInstance().GetFabricTable();
+    if (table.count < chip::FabricTable::kMaxFabrics) {
+        table.fabrics[table.count++].fabric_index = fabric_index;
+    }
+}
+
+void fake_group_add(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::EndpointId endpoint_id) {
+    if (group_entry_count < MAX_GROUP_ENTRIES) {
+        group_entries[group_entry_count++] = {fabric_index, {group_id, endpoint_id}};
+    }
+}
+
+// Platform work queue
+
+typedef struct {
+    chip::DeviceLayer::AsyncWorkFunct function;
+    intptr_t arg;
+} work_item_t;
+
+static work_item_t work_queue[MAX_WORK];
+static size_t work_count = 0;
+
+CHIP_ERROR chip::DeviceLayer::PlatformManager::ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg) {
+    if (work_count == MAX_WORK) {
+        return CHIP_ERROR_NO_MEMORY;
+    }
+    work_queue[work_count++] = {workFunct, arg};
+    return CHIP_NO_ERROR;
+}
+
+chip::DeviceLayer::PlatformManager &chip::DeviceLayer::PlatformMgr() {
+    static PlatformManager platform_manager;
+    return platform_manager;
+}
+
+size_t fake_platform_run_work(void) {
+    size_t ran = 0;
+    // Work scheduled while running goes to the back of the queue and runs in the same call.
+    while (ran < work_count) {
+        work_item_t item = work_queue[ran++];
+        item.function(item.arg);
+    }
+    work_count = 0;
+    return ran;
+}
+
+// Interaction model, group invoke path
+
+static bool handlers_enabled = true;
+static chip::Session group_session;
+static chip::Messaging::ExchangeContext group_exchange;
+static chip::app::CommandHandler command_handler;
+
+void fake_command_handlers_enabled(bool enabled) {
+    handlers_enabled = enabled;
+}
+
+static void on_off_server_invoke(chip::EndpointId endpoint_id, chip::CommandId command_id) {
+    esp_matter_attr_val_t val;
+    if (fake_esp_matter_get(endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val) != ESP_OK) {
+        return;
+    }
+    if (command_id == OnOff::Commands::On::Id) {
+        val.val.b = true;
+    } else if (command_id == OnOff::Commands::Off::Id) {
+        val.val.b = false;
+    } else {
+        val.val.b = !val.val.b;
+    }
+    esp_matter::attribute::update(endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val);
+}
+
+void fake_group_invoke(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::NodeId source_node_id,
+                       uint16_t exchange_id, chip::CommandId command_id, fake_dispatch_observer_t observer,
+                       void *observer_ctx) {
+    group_session.peer_node_id = source_node_id;
+    group_session.fabric_index = fabric_index;
+    group_exchange.exchange_id = exchange_id;
+    group_exchange.session = &group_session;
+    command_handler.subject = {fabric_index, chip::Access::AuthMode::kGroup, chip::NodeIdFromGroupId(group_id)};
+    command_handler.exchange = &group_exchange;
+
+    for (size_t i = 0; i < group_entry_count; i++) {
+        const group_entry_t &entry = group_entries[i];
+        if (entry.fabric_index != fabric_index || entry.mapping.group_id != group_id) {
+            continue;
+        }
+
+        chip::EndpointId endpoint_id = entry.mapping.endpoint_id;
+        esp_matter_attr_val_t val;
+        if (fake_esp_matter_get(endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val) != ESP_OK) {
+            continue;
+        }
+        chip::Access::RequestPath path{OnOff::Id, endpoint_id, chip::Access::RequestType::kCommandInvokeRequest};
+        if (chip::Access::GetAccessControl().Check(command_handler.subject, path,
+                                                   chip::Access::Privilege::kOperate) != CHIP_NO_ERROR) {
+            continue;
+        }
+
+        chip::app::ConcreteCommandPath command_path{endpoint_id, OnOff::Id, command_id};
+        chip::app::CommandHandlerInterface::HandlerContext context(command_handler, command_path);
+        chip::app::CommandHandlerInterface *handler =
+            handlers_enabled
+                ? chip::app::CommandHandlerInterfaceRegistry::Instance().GetCommandHandler(endpoint_id, OnOff::Id)
+                : nullptr;
+        if (handler != nullptr) {
+            handler->InvokeCommand(context);
+        }
+        if (!context.mCommandHandled) {
+            on_off_server_invoke(endpoint_id, command_id);
+        }
+
+        if (observer != nullptr) {
+            observer(endpoint_id, observer_ctx);
+        }
+    }
+}
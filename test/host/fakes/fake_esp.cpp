@@ -0,0 +1,186 @@
+#include "host_fakes.h"
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "led_strip.h"
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:
+            return "ESP_OK";
+        case ESP_FAIL:
+            return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:
+            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:
+            return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:
+            return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:
+            return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:
+            return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED:
+            return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:
+            return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE:
+            return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_CRC:
+            return "ESP_ERR_INVALID_CRC";
+        default:
+            return "UNKNOWN ERROR";
+    }
+}
+
+// Time
+
+static const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time)
+        .count();
+}
+
+// Log
+
+static esp_log_level_t log_level = ESP_LOG_INFO;
+static int log_echo = -1;
+
+// Stands in for the UART console: the line is formatted as on the device, and only echoed on request.
+static int console_vprintf(const char *fmt, va_list args) {
+    char line[256];
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+    if (log_echo < 0) {
+        log_echo = getenv("HOST_LOG") != NULL;
+    }
+    if (log_echo) {
+        fputs(line, stderr);
+    }
+    return len;
+}
+
+static vprintf_like_t log_vprintf = console_vprintf;
+
+void fake_log_echo(bool echo) {
+    log_echo = echo;
+}
+
+void esp_log_level_set(const char *tag, esp_log_level_t level) {
+    log_level = level;
+}
+
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func) {
+    vprintf_like_t previous = log_vprintf;
+    log_vprintf = func;
+    return previous;
+}
+
+uint32_t esp_log_timestamp(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+    if (level > log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    log_vprintf(format, args);
+    va_end(args);
+}
+
+// Heap
+
+static size_t heap_free = 200 * 1024;
+static size_t heap_total = 300 * 1024;
+
+void fake_heap_set(size_t free_bytes, size_t total_bytes) {
+    heap_free = free_bytes;
+    heap_total = total_bytes;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return heap_free;
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+    return heap_total;
+}
+
+// GPIO
+
+static uint32_t gpio_levels[GPIO_NUM_MAX];
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+    if (config == NULL || (config->pin_bit_mask >> GPIO_NUM_MAX) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    gpio_levels[gpio_num] = level != 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return 0;
+    }
+    return (int)gpio_levels[gpio_num];
+}
+
+// LED strip, one pixel
+
+struct led_strip_t {
+    fake_pixel_t pending;
+    fake_pixel_t shown;
+    uint32_t refreshes;
+};
+
+esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const led_strip_rmt_config_t *rmt_config,
+                                   led_strip_handle_t *ret_strip) {
+    if (led_config == NULL || rmt_config == NULL || ret_strip == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *ret_strip = new led_strip_t();
+    return ESP_OK;
+}
+
+esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green,
+                              uint32_t blue) {
+    if (strip == NULL || index != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    strip->pending = {(uint8_t)red, (uint8_t)green, (uint8_t)blue};
+    return ESP_OK;
+}
+
+esp_err_t led_strip_refresh(led_strip_handle_t strip) {
+    if (strip == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    strip->shown = strip->pending;
+    strip->refreshes++;
+    return ESP_OK;
+}
+
+fake_pixel_t fake_led_strip_shown(led_strip_handle_t strip) {
+    return strip->shown;
+}
+
+uint32_t fake_led_strip_refresh_count(led_strip_handle_t strip) {
+    return strip->refreshes;
+}
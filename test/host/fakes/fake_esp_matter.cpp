@@ -0,0 +1,272 @@
+#include "host_fakes.h"
+
+#include "esp_matter.h"
+#include "esp_matter_console.h"
+
+#define MAX_ENDPOINTS 64
+#define MAX_ATTRIBUTES 128
+
+using namespace chip::app::Clusters;
+
+// The handle types are declared in namespace esp_matter by the header.
+namespace esp_matter {
+struct fake_node {
+    esp_matter::attribute::callback_t attribute_callback;
+    esp_matter::identification::callback_t identification_callback;
+    void *priv_data;
+};
+
+struct fake_endpoint {
+    uint16_t id;
+    uint8_t flags;
+    fake_endpoint *parent;
+};
+
+struct fake_cluster {
+    uint32_t id;
+};
+} // namespace esp_matter
+
+using esp_matter::fake_cluster;
+using esp_matter::fake_endpoint;
+using esp_matter::fake_node;
+
+typedef struct {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    esp_matter_attr_val_t val;
+} fake_attribute_t;
+
+static fake_node node_instance;
+static bool node_created = false;
+static fake_endpoint endpoints[MAX_ENDPOINTS];
+static size_t endpoint_count = 0;
+static fake_cluster binding_cluster = {0x001E};
+static fake_cluster diagnostic_logs_cluster = {DiagnosticLogs::Id};
+static void *diagnostic_logs_delegate = nullptr;
+static fake_attribute_t attributes[MAX_ATTRIBUTES];
+static size_t attribute_count = 0;
+static esp_matter::event_callback_t event_callback = nullptr;
+static intptr_t event_callback_arg = 0;
+
+esp_matter_attr_val_t esp_matter_bool(bool val) {
+    esp_matter_attr_val_t attr_val = {};
+    attr_val.type = ESP_MATTER_VAL_TYPE_BOOLEAN;
+    attr_val.val.b = val;
+    return attr_val;
+}
+
+esp_matter_attr_val_t esp_matter_uint8(uint8_t val) {
+    esp_matter_attr_val_t attr_val = {};
+    attr_val.type = ESP_MATTER_VAL_TYPE_UINT8;
+    attr_val.val.u8 = val;
+    return attr_val;
+}
+
+static fake_attribute_t *find_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {
+    for (size_t i = 0; i < attribute_count; i++) {
+        fake_attribute_t *attribute = &attributes[i];
+        if (attribute->endpoint_id == endpoint_id && attribute->cluster_id == cluster_id &&
+            attribute->attribute_id == attribute_id) {
+            return attribute;
+        }
+    }
+    return nullptr;
+}
+
+static esp_err_t add_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                               esp_matter_attr_val_t val) {
+    if (find_attribute(endpoint_id, cluster_id, attribute_id) != nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (attribute_count == MAX_ATTRIBUTES) {
+        return ESP_ERR_NO_MEM;
+    }
+    attributes[attribute_count++] = {endpoint_id, cluster_id, attribute_id, val};
+    return ESP_OK;
+}
+
+static fake_endpoint *add_endpoint(uint8_t flags) {
+    if (!node_created || endpoint_count == MAX_ENDPOINTS) {
+        return nullptr;
+    }
+    fake_endpoint *endpoint = &endpoints[endpoint_count];
+    *endpoint = {(uint16_t)endpoint_count, flags, nullptr};
+    endpoint_count++;
+    return endpoint;
+}
+
+namespace esp_matter {
+
+namespace attribute {
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val) {
+    fake_attribute_t *attribute = find_attribute(endpoint_id, cluster_id, attribute_id);
+    if (attribute == nullptr || val == nullptr || val->type != attribute->val.type) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    attribute::callback_t callback = node_instance.attribute_callback;
+    if (callback != nullptr) {
+        esp_err_t err = callback(PRE_UPDATE, endpoint_id, cluster_id, attribute_id, val, node_instance.priv_data);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    attribute->val = *val;
+    if (callback != nullptr) {
+        callback(POST_UPDATE, endpoint_id, cluster_id, attribute_id, val, node_instance.priv_data);
+    }
+    return ESP_OK;
+}
+} // namespace attribute
+
+namespace node {
+node_t *create(config_t *config, attribute::callback_t attribute_callback,
+               identification::callback_t identification_callback, void *priv_data) {
+    if (node_created) {
+        return nullptr;
+    }
+    node_instance = {attribute_callback, identification_callback, priv_data};
+    node_created = true;
+
+    // Endpoint 0 is the root node.
+    add_endpoint(ENDPOINT_FLAG_NONE);
+    return &node_instance;
+}
+} // namespace node
+
+namespace endpoint {
+endpoint_t *get(node_t *node, uint16_t endpoint_id) {
+    if (node == nullptr || endpoint_id >= endpoint_count) {
+        return nullptr;
+    }
+    return &endpoints[endpoint_id];
+}
+
+uint16_t get_id(endpoint_t *endpoint) {
+    return endpoint->id;
+}
+
+esp_err_t set_parent_endpoint(endpoint_t *endpoint, endpoint_t *parent_endpoint) {
+    if (endpoint == nullptr || parent_endpoint == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    endpoint->parent = parent_endpoint;
+    return ESP_OK;
+}
+
+namespace on_off_light {
+esp_err_t add(endpoint_t *endpoint, config_t *config) {
+    if (endpoint == nullptr || config == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return add_attribute(endpoint->id, OnOff::Id, OnOff::Attributes::OnOff::Id, esp_matter_bool(config->on_off.on_off));
+}
+
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data) {
+    if (node == nullptr || config == nullptr) {
+        return nullptr;
+    }
+    endpoint_t *endpoint = add_endpoint(flags);
+    if (endpoint == nullptr || add(endpoint, config) != ESP_OK) {
+        return nullptr;
+    }
+    return endpoint;
+}
+} // namespace on_off_light
+
+namespace aggregator {
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data) {
+    if (node == nullptr || config == nullptr) {
+        return nullptr;
+    }
+    return add_endpoint(flags);
+}
+} // namespace aggregator
+
+namespace bridged_node {
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data) {
+    if (node == nullptr || config == nullptr) {
+        return nullptr;
+    }
+    endpoint_t *endpoint = add_endpoint(flags);
+    if (endpoint == nullptr ||
+        add_attribute(endpoint->id, BridgedDeviceBasicInformation::Id,
+                      BridgedDeviceBasicInformation::Attributes::Reachable::Id, esp_matter_bool(true)) != ESP_OK) {
+        return nullptr;
+    }
+    return endpoint;
+}
+} // namespace bridged_node
+} // namespace endpoint
+
+namespace cluster {
+namespace binding {
+cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags) {
+    if (endpoint == nullptr || config == nullptr) {
+        return nullptr;
+    }
+    return &binding_cluster;
+}
+} // namespace binding
+
+namespace diagnostic_logs {
+cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags) {
+    if (endpoint == nullptr || config == nullptr || config->delegate == nullptr) {
+        return nullptr;
+    }
+    diagnostic_logs_delegate = config->delegate;
+    return &diagnostic_logs_cluster;
+}
+} // namespace diagnostic_logs
+} // namespace cluster
+
+esp_err_t start(event_callback_t callback, intptr_t callback_arg) {
+    if (!node_created) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    event_callback = callback;
+    event_callback_arg = callback_arg;
+    return ESP_OK;
+}
+
+namespace console {
+esp_err_t add_commands(const command_t *commands, int count) {
+    return ESP_OK;
+}
+
+esp_err_t diagnostics_register_commands(void) {
+    return ESP_OK;
+}
+
+esp_err_t wifi_register_commands(void) {
+    return ESP_OK;
+}
+
+esp_err_t init(void) {
+    return ESP_OK;
+}
+} // namespace console
+
+} // namespace esp_matter
+
+esp_err_t fake_esp_matter_get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                              esp_matter_attr_val_t *val) {
+    fake_attribute_t *attribute = find_attribute(endpoint_id, cluster_id, attribute_id);
+    if (attribute == nullptr) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *val = attribute->val;
+    return ESP_OK;
+}
+
+void *fake_esp_matter_diagnostic_logs_delegate(void) {
+    return diagnostic_logs_delegate;
+}
+
+void fake_esp_matter_post_event(const ChipDeviceEvent *event) {
+    if (event_callback != nullptr) {
+        event_callback(event, event_callback_arg);
+    }
+}
@@ -0,0 +1,127 @@
+#include "host_fakes.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <setjmp.h>
+#include <string.h>
+
+#define MAX_TASKS 8
+
+struct fake_task {
+    TaskFunction_t function;
+    void *parameter;
+    const char *name;
+    uint32_t stack_depth;
+    UBaseType_t priority;
+    BaseType_t core_id;
+    uint32_t notifications;
+};
+
+static fake_task tasks[MAX_TASKS];
+static size_t task_count = 0;
+static TickType_t tick_count = 0;
+
+static thread_local fake_task *running_task = NULL;
+static thread_local uint32_t blocks_left = 0;
+static thread_local jmp_buf *run_exit = NULL;
+
+// Called wherever the task would block. The n-th block of a run leaves the task instead of returning.
+static void task_block(TickType_t ticks) {
+    if (running_task != NULL && --blocks_left == 0) {
+        longjmp(*run_exit, 1);
+    }
+    tick_count += ticks;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stack_depth,
+                                   void *parameter, UBaseType_t priority, TaskHandle_t *created_task,
+                                   BaseType_t core_id) {
+    if (task_count == MAX_TASKS) {
+        return pdFAIL;
+    }
+    fake_task *task = &tasks[task_count++];
+    *task = {function, parameter, name, stack_depth, priority, core_id, 0};
+    if (created_task != NULL) {
+        *created_task = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack_depth, void *parameter,
+                       UBaseType_t priority, TaskHandle_t *created_task) {
+    return xTaskCreatePinnedToCore(function, name, stack_depth, parameter, priority, created_task, tskNO_AFFINITY);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    task_block(ticks);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return tick_count;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_count_on_exit, TickType_t ticks_to_wait) {
+    fake_task *task = running_task;
+    if (task == NULL) {
+        return 0;
+    }
+    if (task->notifications == 0) {
+        // Nothing else runs while the task waits, so the wait always times out.
+        task_block(ticks_to_wait);
+        return 0;
+    }
+    uint32_t count = task->notifications;
+    task->notifications = clear_count_on_exit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    __atomic_add_fetch(&task->notifications, 1, __ATOMIC_RELAXED);
+    return pdPASS;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    // Host stacks are not bounded by the requested depth, so report it as untouched.
+    if (task == NULL) {
+        task = running_task;
+    }
+    return task != NULL ? task->stack_depth : 0;
+}
+
+TaskHandle_t fake_task_find(const char *name) {
+    for (size_t i = 0; i < task_count; i++) {
+        if (strcmp(tasks[i].name, name) == 0) {
+            return &tasks[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t fake_task_stack_depth(TaskHandle_t task) {
+    return task->stack_depth;
+}
+
+UBaseType_t fake_task_priority(TaskHandle_t task) {
+    return task->priority;
+}
+
+BaseType_t fake_task_core(TaskHandle_t task) {
+    return task->core_id;
+}
+
+void fake_task_run(TaskHandle_t task, uint32_t blocks) {
+    if (task == NULL || blocks == 0) {
+        return;
+    }
+
+    jmp_buf exit;
+    running_task = task;
+    blocks_left = blocks;
+    run_exit = &exit;
+    if (setjmp(exit) == 0) {
+        task->function(task->parameter);
+    }
+    running_task = NULL;
+    run_exit = NULL;
+}
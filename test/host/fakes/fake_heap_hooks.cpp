@@ -0,0 +1,53 @@
+// With CONFIG_HEAP_USE_HOOKS, ESP-IDF calls esp_heap_trace_alloc_hook() and esp_heap_trace_free_hook()
+// from every heap allocation and free. On the host, malloc and friends are interposed to do the same, so
+// new and every libc allocation go through the hooks too.
+
+#include "esp_heap_caps.h"
+
+#include <stddef.h>
+
+extern "C" {
+
+void esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps);
+void esp_heap_trace_free_hook(void *ptr);
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    void *ptr = __libc_malloc(size);
+    if (ptr != NULL) {
+        esp_heap_trace_alloc_hook(ptr, size, MALLOC_CAP_DEFAULT);
+    }
+    return ptr;
+}
+
+void *calloc(size_t count, size_t size) {
+    void *ptr = __libc_calloc(count, size);
+    if (ptr != NULL) {
+        esp_heap_trace_alloc_hook(ptr, count * size, MALLOC_CAP_DEFAULT);
+    }
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size) {
+    void *new_ptr = __libc_realloc(ptr, size);
+    if (new_ptr != NULL) {
+        if (ptr != NULL) {
+            esp_heap_trace_free_hook(ptr);
+        }
+        esp_heap_trace_alloc_hook(new_ptr, size, MALLOC_CAP_DEFAULT);
+    }
+    return new_ptr;
+}
+
+void free(void *ptr) {
+    if (ptr != NULL) {
+        esp_heap_trace_free_hook(ptr);
+    }
+    __libc_free(ptr);
+}
+
+} // extern "C"
@@ -0,0 +1,214 @@
+#include "host_fakes.h"
+
+#include "modbus_rtu.h"
+#include "modbus_transport.h"
+
+#include <string.h>
+
+#define MAX_SLAVES 8
+#define MAX_FRAME 64
+#define BITS_PER_CHAR 11
+
+typedef struct {
+    uint8_t address;
+    uint16_t coil_count;
+    uint32_t coils;
+    bool online;
+} fake_slave_t;
+
+static fake_slave_t slaves[MAX_SLAVES];
+static size_t slave_count = 0;
+static uint32_t bus_baud_rate = 9600;
+static bool corrupt_next = false;
+static fake_modbus_stats_t stats;
+
+// Response waiting to be read by the master.
+static uint8_t response[MAX_FRAME];
+static size_t response_len = 0;
+static size_t response_pos = 0;
+
+// Written independently of the master's CRC code, so the two check each other.
+static uint16_t crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t char_time_us(size_t chars) {
+    return (uint32_t)((uint64_t)chars * BITS_PER_CHAR * 1000000 / bus_baud_rate);
+}
+
+static void bus_time(uint32_t us) {
+    stats.bus_time_us += us;
+}
+
+static fake_slave_t *find_slave(uint8_t address) {
+    for (size_t i = 0; i < slave_count; i++) {
+        if (slaves[i].address == address) {
+            return &slaves[i];
+        }
+    }
+    return nullptr;
+}
+
+static uint32_t coil_mask(uint16_t count) {
+    return count < 32 ? (1UL << count) - 1 : 0xFFFFFFFF;
+}
+
+static void respond(const uint8_t *frame, size_t len) {
+    memcpy(response, frame, len);
+    uint16_t crc = crc16(response, len);
+    response[len++] = crc & 0xFF;
+    response[len++] = crc >> 8;
+    if (corrupt_next) {
+        response[len - 1] ^= 0xFF;
+        corrupt_next = false;
+    }
+    response_len = len;
+    response_pos = 0;
+    bus_time(char_time_us(len));
+}
+
+static void respond_exception(uint8_t address, uint8_t function, uint8_t code) {
+    const uint8_t frame[] = {address, (uint8_t)(function | 0x80), code};
+    respond(frame, sizeof(frame));
+}
+
+static void serve(fake_slave_t *slave, const uint8_t *request, size_t len) {
+    uint8_t function = request[1];
+    uint16_t start = (request[2] << 8) | request[3];
+    uint16_t count = (request[4] << 8) | request[5];
+
+    if (function != 0x01 && function != 0x0F) {
+        respond_exception(slave->address, function, 0x01);
+        return;
+    }
+    if (count == 0 || start + count > slave->coil_count) {
+        respond_exception(slave->address, function, 0x02);
+        return;
+    }
+
+    if (function == 0x01) {
+        stats.reads++;
+        uint32_t values = (slave->coils >> start) & coil_mask(count);
+        uint8_t frame[3 + 4] = {slave->address, function, (uint8_t)((count + 7) / 8)};
+        for (size_t i = 0; i < frame[2]; i++) {
+            frame[3 + i] = (values >> (8 * i)) & 0xFF;
+        }
+        respond(frame, 3 + frame[2]);
+        return;
+    }
+
+    size_t bytes = (count + 7) / 8;
+    if (len != 7 + bytes || request[6] != bytes) {
+        respond_exception(slave->address, function, 0x03);
+        return;
+    }
+    stats.writes++;
+    uint32_t values = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        values |= (uint32_t)request[7 + i] << (8 * i);
+    }
+    uint32_t mask = coil_mask(count) << start;
+    slave->coils = (slave->coils & ~mask) | ((values << start) & mask);
+    respond(request, 6);
+}
+
+static void sim_flush(void *ctx) {
+    response_len = 0;
+    response_pos = 0;
+}
+
+static esp_err_t sim_write(void *ctx, const uint8_t *data, size_t len) {
+    // The UART transport waits out the frame gap right after the previous response.
+    bus_time(MODBUS_RTU_FRAME_GAP_US(bus_baud_rate) + char_time_us(len));
+    response_len = 0;
+    response_pos = 0;
+
+    // Slaves ignore frames that are too short, fail the CRC or are addressed to someone else.
+    if (len < 4 || len > MAX_FRAME) {
+        return ESP_OK;
+    }
+    uint16_t crc = crc16(data, len - 2);
+    if (data[len - 2] != (crc & 0xFF) || data[len - 1] != (crc >> 8)) {
+        return ESP_OK;
+    }
+    fake_slave_t *slave = find_slave(data[0]);
+    if (slave == nullptr || !slave->online || len < 8) {
+        return ESP_OK;
+    }
+    serve(slave, data, len - 2);
+    return ESP_OK;
+}
+
+static int sim_read(void *ctx, uint8_t *data, size_t len, uint32_t timeout_ms) {
+    size_t available = response_len - response_pos;
+    size_t n = len < available ? len : available;
+    memcpy(data, response + response_pos, n);
+    response_pos += n;
+    if (n < len) {
+        // The master waits out the whole timeout for the missing bytes.
+        stats.timeouts++;
+        bus_time(timeout_ms * 1000);
+    }
+    return (int)n;
+}
+
+void fake_modbus_reset(uint32_t baud_rate) {
+    slave_count = 0;
+    bus_baud_rate = baud_rate;
+    corrupt_next = false;
+    stats = {};
+    response_len = 0;
+    response_pos = 0;
+}
+
+void fake_modbus_add_slave(uint8_t address, uint16_t coil_count) {
+    if (slave_count < MAX_SLAVES) {
+        slaves[slave_count++] = {address, coil_count, 0, true};
+    }
+}
+
+void fake_modbus_set_online(uint8_t address, bool online) {
+    fake_slave_t *slave = find_slave(address);
+    if (slave != nullptr) {
+        slave->online = online;
+    }
+}
+
+void fake_modbus_set_coils(uint8_t address, uint32_t values) {
+    fake_slave_t *slave = find_slave(address);
+    if (slave != nullptr) {
+        slave->coils = values & coil_mask(slave->coil_count);
+    }
+}
+
+uint32_t fake_modbus_coils(uint8_t address) {
+    fake_slave_t *slave = find_slave(address);
+    return slave != nullptr ? slave->coils : 0;
+}
+
+void fake_modbus_corrupt_next_response(void) {
+    corrupt_next = true;
+}
+
+fake_modbus_stats_t fake_modbus_stats(void) {
+    return stats;
+}
+
+void fake_modbus_transport(modbus_transport_t *transport) {
+    transport->flush = sim_flush;
+    transport->write = sim_write;
+    transport->read = sim_read;
+    transport->ctx = nullptr;
+}
+
+esp_err_t modbus_transport_uart_init(modbus_transport_t *transport) {
+    fake_modbus_transport(transport);
+    return ESP_OK;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+// Hooks that let host tests drive and inspect the fakes. Not part of any ESP-IDF or esp-matter API.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/core/DataModelTypes.h>
+
+#include "driver/gpio.h"
+#include "esp_matter.h"
+#include "freertos/task.h"
+#include "led_strip.h"
+#include "modbus_transport.h"
+
+typedef struct {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+} fake_pixel_t;
+
+// Colour of the first pixel as of the last refresh, and how many refreshes the strip has had.
+fake_pixel_t fake_led_strip_shown(led_strip_handle_t strip);
+uint32_t fake_led_strip_refresh_count(led_strip_handle_t strip);
+
+// Sets what heap_caps_get_free_size() and heap_caps_get_total_size() report.
+void fake_heap_set(size_t free_bytes, size_t total_bytes);
+
+// Echoes log lines to stderr; also enabled by setting HOST_LOG in the environment.
+void fake_log_echo(bool echo);
+
+// Looks a task up by the name it was created with; NULL if there is none.
+TaskHandle_t fake_task_find(const char *name);
+uint32_t fake_task_stack_depth(TaskHandle_t task);
+UBaseType_t fake_task_priority(TaskHandle_t task);
+BaseType_t fake_task_core(TaskHandle_t task);
+
+// Runs a task on the calling thread until it blocks for the n-th time; that block does not return.
+// A blocked task restarts from the top of its function on the next run, so it must not keep state in
+// locals across a block, and no object with a destructor may be alive at the block.
+void fake_task_run(TaskHandle_t task, uint32_t blocks);
+
+// Reads an attribute as last written through esp_matter::attribute::update() or endpoint creation.
+esp_err_t fake_esp_matter_get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                              esp_matter_attr_val_t *val);
+
+// Returns the delegate passed to esp_matter::cluster::diagnostic_logs::create(), or NULL.
+void *fake_esp_matter_diagnostic_logs_delegate(void);
+
+// Delivers a device event to the callback passed to esp_matter::start().
+void fake_esp_matter_post_event(const ChipDeviceEvent *event);
+
+// Simulated RS-485 bus with Modbus RTU slaves serving Read Coils and Write Multiple Coils. The
+// modbus_transport_uart_init() fake binds to it. Bus time is simulated from the frame sizes at the
+// configured baud rate, 11 bits per character, plus the frame gap the UART transport waits before each
+// request.
+typedef struct {
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t timeouts;
+    uint64_t bus_time_us;  // Total simulated bus time.
+} fake_modbus_stats_t;
+
+void fake_modbus_reset(uint32_t baud_rate);
+void fake_modbus_add_slave(uint8_t address, uint16_t coil_count);
+void fake_modbus_set_online(uint8_t address, bool online);
+// Changes coils behind the master's back, as a local switch on the module would.
+void fake_modbus_set_coils(uint8_t address, uint32_t values);
+uint32_t fake_modbus_coils(uint8_t address);
+void fake_modbus_corrupt_next_response(void);
+fake_modbus_stats_t fake_modbus_stats(void);
+void fake_modbus_transport(modbus_transport_t *transport);
+
+// Adds a fabric to the fabric table and a group membership to the group data provider.
+void fake_fabric_add(chip::FabricIndex fabric_index);
+void fake_group_add(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::EndpointId endpoint_id);
+
+// Withholds Operate privilege on an endpoint from group subjects.
+void fake_access_deny(chip::EndpointId endpoint_id);
+
+// Runs the work queued with PlatformMgr().ScheduleWork() and returns how many items ran.
+size_t fake_platform_run_work(void);
+
+typedef void (*fake_dispatch_observer_t)(chip::EndpointId endpoint_id, void *ctx);
+
+// Processes a multicast OnOff command as the interaction model does. It is dispatched once per member
+// endpoint that has the OnOff cluster and passes access control: to a matching registered command
+// handler first and, if none handles it, to the OnOff server, which writes the OnOff attribute. All
+// dispatches share one pooled CommandHandler. The observer, if any, runs after each dispatch.
+void fake_group_invoke(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::NodeId source_node_id,
+                       uint16_t exchange_id, chip::CommandId command_id, fake_dispatch_observer_t observer,
+                       void *observer_ctx);
+
+// Bypasses the registered command handlers, so only the OnOff server acts on commands.
+void fake_command_handlers_enabled(bool enabled);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+
+class ChipError {
+public:
+    constexpr explicit ChipError(uint32_t code) : code(code) {}
+
+    constexpr bool operator==(const ChipError &other) const { return code == other.code; }
+    constexpr bool operator!=(const ChipError &other) const { return code != other.code; }
+    constexpr uint32_t AsInteger() const { return code; }
+
+private:
+    uint32_t code;
+};
+
+} // namespace chip
+
+using CHIP_ERROR = chip::ChipError;
+
+#define CHIP_NO_ERROR chip::ChipError(0)
+#define CHIP_ERROR_NO_MEMORY chip::ChipError(0x0B)
+#define CHIP_ERROR_READ_FAILED chip::ChipError(0x11)
+#define CHIP_ERROR_INVALID_ARGUMENT chip::ChipError(0x2F)
+#define CHIP_ERROR_ACCESS_DENIED chip::ChipError(0x7E)
+#define CHIP_ERROR_NOT_FOUND chip::ChipError(0xAF)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+
+typedef uint16_t EndpointId;
+typedef uint32_t ClusterId;
+typedef uint32_t AttributeId;
+typedef uint32_t CommandId;
+typedef uint16_t GroupId;
+typedef uint8_t FabricIndex;
+typedef uint64_t NodeId;
+
+static constexpr FabricIndex kUndefinedFabricIndex = 0;
+
+} // namespace chip
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+namespace chip {
+
+static constexpr NodeId kMinGroupNodeId = 0xFFFFFFFFFFFF0000ULL;
+
+constexpr NodeId NodeIdFromGroupId(GroupId group_id) {
+    return kMinGroupNodeId | group_id;
+}
+
+constexpr GroupId GroupIdFromNodeId(NodeId node_id) {
+    return (GroupId)(node_id & 0xFFFF);
+}
+
+} // namespace chip
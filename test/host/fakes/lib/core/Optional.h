@@ -0,0 +1,30 @@
+#pragma once
+
+namespace chip {
+
+struct NullOptionalType {
+};
+
+constexpr NullOptionalType NullOptional{};
+
+template <typename T>
+class Optional {
+public:
+    constexpr Optional() : has_value(false), value() {}
+    constexpr Optional(NullOptionalType) : has_value(false), value() {}
+    constexpr explicit Optional(const T &value) : has_value(true), value(value) {}
+
+    void SetValue(const T &new_value) {
+        value = new_value;
+        has_value = true;
+    }
+
+    constexpr bool HasValue() const { return has_value; }
+    constexpr const T &Value() const { return value; }
+
+private:
+    bool has_value;
+    T value;
+};
+
+} // namespace chip
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+class MutableByteSpan {
+public:
+    constexpr MutableByteSpan() : buffer(nullptr), length(0) {}
+    constexpr MutableByteSpan(uint8_t *data, size_t size) : buffer(data), length(size) {}
+
+    constexpr uint8_t *data() const { return buffer; }
+    constexpr size_t size() const { return length; }
+    void reduce_size(size_t new_size) {
+        if (new_size < length) {
+            length = new_size;
+        }
+    }
+
+private:
+    uint8_t *buffer;
+    size_t length;
+};
+
+} // namespace chip
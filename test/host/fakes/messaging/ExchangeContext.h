@@ -0,0 +1,49 @@
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+namespace chip {
+
+class ScopedNodeId {
+public:
+    ScopedNodeId(NodeId node_id, FabricIndex fabric_index) : node_id(node_id), fabric_index(fabric_index) {}
+
+    NodeId GetNodeId() const { return node_id; }
+    FabricIndex GetFabricIndex() const { return fabric_index; }
+
+private:
+    NodeId node_id;
+    FabricIndex fabric_index;
+};
+
+class Session {
+public:
+    ScopedNodeId GetPeer() const { return ScopedNodeId(peer_node_id, fabric_index); }
+
+    NodeId peer_node_id = 0;
+    FabricIndex fabric_index = kUndefinedFabricIndex;
+};
+
+class SessionHandle {
+public:
+    explicit SessionHandle(Session &session) : session(&session) {}
+
+    Session *operator->() const { return session; }
+
+private:
+    Session *session;
+};
+
+namespace Messaging {
+
+class ExchangeContext {
+public:
+    uint16_t GetExchangeId() const { return exchange_id; }
+    SessionHandle GetSessionHandle() const { return SessionHandle(*session); }
+
+    uint16_t exchange_id = 0;
+    Session *session = nullptr;
+};
+
+} // namespace Messaging
+} // namespace chip
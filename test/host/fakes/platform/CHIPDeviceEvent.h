@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+namespace DeviceEventType {
+enum {
+    kWiFiConnectivityChange = 0x8000,
+    kThreadConnectivityChange,
+    kInternetConnectivityChange,
+    kServiceConnectivityChange,
+    kServiceProvisioningChange,
+    kTimeSyncChange,
+    kCHIPoBLEConnectionEstablished,
+    kCHIPoBLEConnectionClosed,
+    kCloseAllBleConnections,
+    kWiFiDeviceAvailable,
+    kOperationalNetworkStarted,
+    kThreadStateChange,
+    kThreadInterfaceStateChange,
+    kCHIPoBLEAdvertisingChange,
+    kInterfaceIpAddressChanged,
+    kCommissioningComplete,
+    kFailSafeTimerExpired,
+    kOperationalNetworkEnabled,
+    kDnssdInitialized,
+    kDnssdRestartNeeded,
+    kBindingsChangedViaCluster,
+    kOtaStateChanged,
+    kServerReady,
+    kBLEDeinitialized,
+    kCommissioningSessionStarted,
+    kCommissioningSessionStopped,
+    kCommissioningWindowOpened,
+    kCommissioningWindowClosed,
+    kFabricWillBeRemoved,
+    kFabricRemoved,
+    kFabricCommitted,
+    kFabricUpdated,
+};
+} // namespace DeviceEventType
+
+enum ConnectivityChange {
+    kConnectivity_NoChange = 0,
+    kConnectivity_Established = 1,
+    kConnectivity_Lost = -1,
+};
+
+enum class InterfaceIpChangeType {
+    kIpV4_Assigned,
+    kIpV4_Lost,
+    kIpV6_Assigned,
+    kIpV6_Lost,
+};
+
+struct ChipDeviceEvent {
+    uint16_t Type;
+
+    union {
+        struct {
+            ConnectivityChange Result;
+        } WiFiConnectivityChange;
+        struct {
+            ConnectivityChange Result;
+        } ThreadConnectivityChange;
+        struct {
+            ConnectivityChange IPv4;
+            ConnectivityChange IPv6;
+        } InternetConnectivityChange;
+        struct {
+            struct {
+                ConnectivityChange Result;
+            } Overall;
+        } ServiceConnectivityChange;
+        struct {
+            bool RoleChanged;
+            bool AddressChanged;
+            bool NetDataChanged;
+            bool ChildNodesChanged;
+        } ThreadStateChange;
+        struct {
+            InterfaceIpChangeType Type;
+        } InterfaceIpAddressChanged;
+    };
+};
+
+} // namespace DeviceLayer
+} // namespace chip
+
+using chip::DeviceLayer::ChipDeviceEvent;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+typedef void (*AsyncWorkFunct)(intptr_t arg);
+
+// Scheduled work is queued until fake_platform_run_work() runs it, as the Matter event loop would.
+class PlatformManager {
+public:
+    CHIP_ERROR ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg = 0);
+};
+
+PlatformManager &PlatformMgr();
+
+} // namespace DeviceLayer
+} // namespace chip
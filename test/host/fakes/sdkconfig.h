@@ -0,0 +1,52 @@
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+// Host build configuration. Every option can be overridden from CMake with a compile definition.
+
+#ifndef CONFIG_IDF_TARGET_ESP32
+#define CONFIG_IDF_TARGET_ESP32 1
+#endif
+
+// ESP-IDF's default, which sdkconfig.defaults keeps.
+#ifndef CONFIG_FREERTOS_HZ
+#define CONFIG_FREERTOS_HZ 100
+#endif
+
+#ifndef CONFIG_ENABLE_CHIP_SHELL
+#define CONFIG_ENABLE_CHIP_SHELL 0
+#endif
+
+#ifndef CONFIG_APP_ALLOC_TRACER
+#define CONFIG_APP_ALLOC_TRACER 0
+#endif
+
+#ifndef CONFIG_APP_GROUPS_PER_RELAY
+#define CONFIG_APP_GROUPS_PER_RELAY 4
+#endif
+
+#ifndef CONFIG_APP_BRIDGE_ENABLED
+#define CONFIG_APP_BRIDGE_ENABLED 0
+#endif
+
+#if CONFIG_APP_BRIDGE_ENABLED
+#ifndef CONFIG_APP_BRIDGE_UART_PORT
+#define CONFIG_APP_BRIDGE_UART_PORT 1
+#endif
+#ifndef CONFIG_APP_BRIDGE_BAUD_RATE
+#define CONFIG_APP_BRIDGE_BAUD_RATE 9600
+#endif
+#ifndef CONFIG_APP_BRIDGE_MODULE_COUNT
+#define CONFIG_APP_BRIDGE_MODULE_COUNT 2
+#endif
+#ifndef CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS
+#define CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS 1
+#endif
+#ifndef CONFIG_APP_BRIDGE_COILS_PER_MODULE
+#define CONFIG_APP_BRIDGE_COILS_PER_MODULE 8
+#endif
+#ifndef CONFIG_APP_BRIDGE_POLL_INTERVAL_MS
+#define CONFIG_APP_BRIDGE_POLL_INTERVAL_MS 200
+#endif
+#endif // CONFIG_APP_BRIDGE_ENABLED
+
+#endif // SDKCONFIG_H
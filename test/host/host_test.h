@@ -0,0 +1,51 @@
+#pragma once
+
+// Minimal check and benchmark helpers shared by the host tests.
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+static int host_test_failures = 0;
+
+#define HOST_CHECK(cond)                                                         \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            host_test_failures++;                                                \
+        }                                                                        \
+    } while (0)
+
+// Returns the process exit status for ctest.
+static inline int host_test_result(void) {
+    if (host_test_failures != 0) {
+        fprintf(stderr, "%d check(s) failed\n", host_test_failures);
+        return 1;
+    }
+    return 0;
+}
+
+// Keeps a benchmarked result alive so the compiler cannot drop the work that produced it.
+template <typename T>
+static inline void host_bench_keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Runs fn the given number of times, five times over, and prints the best mean time per call.
+template <typename Fn>
+static double host_bench(const char *name, uint32_t iterations, Fn fn) {
+    double best_ns = 0;
+    for (int round = 0; round < 5; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            fn(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        if (round == 0 || ns < best_ns) {
+            best_ns = ns;
+        }
+    }
+    printf("%-48s %10.1f ns/op\n", name, best_ns);
+    return best_ns;
+}
@@ -0,0 +1,195 @@
+// Runs the relay toggle paths with the allocation tracer on and every heap allocation hooked, and checks
+// that none of the traced regions allocates once warmed up, and that each allocation is reported once.
+
+#include "host_test.h"
+#include "host_fakes.h"
+
+#include "alloc_tracer.h"
+#include "events.h"
+#include "matter_interface.h"
+#include "relay.h"
+
+#include <esp_matter.h>
+#include <app/clusters/diagnostic-logs-server/DiagnosticLogsProviderDelegate.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define TOGGLES 1000
+#define WARM_UP_TOGGLES 3
+#define FIRST_SLAVE CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS
+#define FABRIC 1
+#define GROUP 0x0101
+#define CONCURRENT_ALLOCATIONS 1000
+
+using esp_matter::attribute::callback_type_t;
+using namespace chip::app::Clusters;
+using namespace chip::app::Clusters::DiagnosticLogs;
+
+static const char *region_names[ALLOC_REGION_COUNT] = {
+    "attribute_callback",
+    "relay_set",
+    "matter_update",
+    "diagnostic_log",
+};
+
+static uint16_t relay_endpoint;
+static uint16_t first_bridged_endpoint;
+static TaskHandle_t bridge_task;
+static uint16_t exchange_id = 0;
+
+static void on_off_callback(callback_type_t type, uint16_t endpoint_id, bool state) {
+    esp_matter_attr_val_t val = esp_matter_bool(state);
+    HOST_CHECK(matter_attribute_update_callback(type, endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val,
+                                                nullptr) == ESP_OK);
+}
+
+// One round of every way the relays get switched: a controller write to the local and a bridged relay,
+// a local state change pushed to Matter, a group command, and a coil switched on the module itself.
+static void toggle_round(uint32_t i) {
+    bool state = i & 1;
+
+    on_off_callback(callback_type_t::PRE_UPDATE, relay_endpoint, state);
+    on_off_callback(callback_type_t::POST_UPDATE, relay_endpoint, state);
+    HOST_CHECK(matter_update_value(relay_endpoint, !state) == ESP_OK);
+
+    on_off_callback(callback_type_t::PRE_UPDATE, first_bridged_endpoint, state);
+    on_off_callback(callback_type_t::POST_UPDATE, first_bridged_endpoint, state);
+
+    fake_group_invoke(FABRIC, GROUP, 0x1111, ++exchange_id, OnOff::Commands::Toggle::Id, nullptr, nullptr);
+    fake_platform_run_work();
+
+    fake_modbus_set_coils(FIRST_SLAVE + 1, fake_modbus_coils(FIRST_SLAVE + 1) ^ 0x80);
+    fake_task_run(bridge_task, 2);
+}
+
+static void snapshot(alloc_region_stats_t stats[ALLOC_REGION_COUNT]) {
+    for (int region = 0; region < ALLOC_REGION_COUNT; region++) {
+        alloc_tracer_get((alloc_region_t)region, &stats[region]);
+    }
+}
+
+static void test_steady_state(void) {
+    for (uint32_t i = 0; i < WARM_UP_TOGGLES; i++) {
+        toggle_round(i);
+    }
+
+    alloc_region_stats_t before[ALLOC_REGION_COUNT];
+    alloc_region_stats_t after[ALLOC_REGION_COUNT];
+    snapshot(before);
+    for (uint32_t i = 0; i < TOGGLES; i++) {
+        toggle_round(i);
+    }
+    snapshot(after);
+
+    for (int region = 0; region < ALLOC_REGION_COUNT; region++) {
+        uint32_t count = after[region].count - before[region].count;
+        uint32_t bytes = after[region].bytes - before[region].bytes;
+        printf("%-48s %10u allocations, %u bytes\n", region_names[region], (unsigned int)count,
+               (unsigned int)bytes);
+        HOST_CHECK(count == 0);
+        HOST_CHECK(alloc_tracer_check((alloc_region_t)region));
+    }
+
+    // The last round left the local relay as its controller write set it, flipped twice since.
+    HOST_CHECK(relay_get() == (bool)((TOGGLES - 1) & 1));
+}
+
+static void allocate_in(alloc_region_t region) {
+    AllocTraceScope trace(region);
+    char *buffer = new char[32];
+    host_bench_keep(buffer);
+    delete[] buffer;
+}
+
+// The hooks must see allocations, or the test above proves nothing.
+static void test_detection(void) {
+    alloc_region_stats_t before;
+    alloc_region_stats_t after;
+    alloc_tracer_get(ALLOC_REGION_RELAY_SET, &before);
+    allocate_in(ALLOC_REGION_RELAY_SET);
+    alloc_tracer_get(ALLOC_REGION_RELAY_SET, &after);
+    HOST_CHECK(after.count == before.count + 1);
+    HOST_CHECK(after.bytes == before.bytes + 32);
+    HOST_CHECK(!alloc_tracer_check(ALLOC_REGION_RELAY_SET));
+    HOST_CHECK(alloc_tracer_check(ALLOC_REGION_RELAY_SET));
+}
+
+// The Matter task and the bridge task check regions concurrently. Each allocation must be reported by at
+// most one check, so there are never more failed checks than allocations.
+static void test_concurrent_checks(void) {
+    HOST_CHECK(alloc_tracer_check(ALLOC_REGION_MATTER_UPDATE));
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> reported(0);
+    auto check = [&done, &reported]() {
+        while (!done.load()) {
+            reported += !alloc_tracer_check(ALLOC_REGION_MATTER_UPDATE);
+        }
+    };
+    std::thread first(check);
+    std::thread second(check);
+    for (uint32_t i = 0; i < CONCURRENT_ALLOCATIONS; i++) {
+        allocate_in(ALLOC_REGION_MATTER_UPDATE);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    done.store(true);
+    first.join();
+    second.join();
+    reported += !alloc_tracer_check(ALLOC_REGION_MATTER_UPDATE);
+
+    HOST_CHECK(reported > 0);
+    HOST_CHECK(reported <= CONCURRENT_ALLOCATIONS);
+}
+
+// Log capture allocations are reported when a log is pulled, not by the toggle path.
+static void test_log_region(void) {
+    auto *provider = static_cast<DiagnosticLogsProviderDelegate *>(fake_esp_matter_diagnostic_logs_delegate());
+    HOST_CHECK(provider != nullptr);
+    if (provider == nullptr) {
+        return;
+    }
+
+    allocate_in(ALLOC_REGION_DIAGNOSTIC_LOG);
+    toggle_round(0);
+    HOST_CHECK(!alloc_tracer_check(ALLOC_REGION_DIAGNOSTIC_LOG));
+
+    allocate_in(ALLOC_REGION_DIAGNOSTIC_LOG);
+    HOST_CHECK(provider->GetSizeForIntent(IntentEnum::kEndUserSupport) > 0);
+    LogSessionHandle handle = kInvalidLogSessionHandle;
+    chip::Optional<uint64_t> time_stamp;
+    chip::Optional<uint64_t> time_since_boot;
+    HOST_CHECK(provider->StartLogCollection(IntentEnum::kEndUserSupport, handle, time_stamp, time_since_boot) ==
+               CHIP_NO_ERROR);
+    provider->EndLogCollection(handle);
+    HOST_CHECK(alloc_tracer_check(ALLOC_REGION_DIAGNOSTIC_LOG));
+}
+
+int main(void) {
+    fake_modbus_reset(CONFIG_APP_BRIDGE_BAUD_RATE);
+    for (int i = 0; i < CONFIG_APP_BRIDGE_MODULE_COUNT; i++) {
+        fake_modbus_add_slave(FIRST_SLAVE + i, CONFIG_APP_BRIDGE_COILS_PER_MODULE);
+    }
+
+    HOST_CHECK(relay_init() == ESP_OK);
+    HOST_CHECK(matter_init(&relay_endpoint) == ESP_OK);
+    fake_platform_run_work();
+    first_bridged_endpoint = relay_endpoint + 2;
+    bridge_task = fake_task_find("bridge_task");
+    HOST_CHECK(bridge_task != nullptr);
+    if (bridge_task == nullptr) {
+        return host_test_result();
+    }
+
+    fake_fabric_add(FABRIC);
+    fake_group_add(FABRIC, GROUP, relay_endpoint);
+    fake_group_add(FABRIC, GROUP, first_bridged_endpoint + 1);
+    fake_group_add(FABRIC, GROUP, first_bridged_endpoint + CONFIG_APP_BRIDGE_COILS_PER_MODULE);
+
+    test_steady_state();
+    test_detection();
+    test_concurrent_checks();
+    test_log_region();
+
+    return host_test_result();
+}
@@ -0,0 +1,156 @@
+// Tests the attribute handler table lookup: phase filtering, value type rejection and unhandled paths,
+// and times a lookup as the number of handlers grows.
+
+#include "host_test.h"
+#include "host_fakes.h"
+
+#include "attribute_handlers.h"
+#include "matter_interface.h"
+#include "relay.h"
+
+#include <esp_matter.h>
+#include <stdio.h>
+
+#define MAX_HANDLERS 256
+#define CLUSTER_BASE 0x1000
+
+using esp_matter::attribute::callback_type_t;
+using namespace chip::app::Clusters;
+
+static uint32_t pre_calls = 0;
+static uint32_t post_calls = 0;
+
+static esp_err_t count_pre(uint16_t endpoint_id, esp_matter_attr_val_t *val) {
+    pre_calls++;
+    return ESP_OK;
+}
+
+static esp_err_t count_post(uint16_t endpoint_id, esp_matter_attr_val_t *val) {
+    post_calls++;
+    return ESP_OK;
+}
+
+static esp_err_t reject(uint16_t endpoint_id, esp_matter_attr_val_t *val) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static esp_err_t dispatch(const attribute_handler_t *table, size_t count, callback_type_t type, uint32_t cluster_id,
+                          uint32_t attribute_id, esp_matter_attr_val_t *val) {
+    return attribute_handler_table_dispatch(table, count, type, 1, attribute_key(cluster_id, attribute_id), val);
+}
+
+static void test_table(void) {
+    static const attribute_handler_t table[] = {
+        {attribute_key(6, 0), ESP_MATTER_VAL_TYPE_BOOLEAN, callback_type_t::PRE_UPDATE, count_pre},
+        {attribute_key(6, 0), ESP_MATTER_VAL_TYPE_BOOLEAN, callback_type_t::POST_UPDATE, count_post},
+        {attribute_key(8, 0), ESP_MATTER_VAL_TYPE_UINT8, callback_type_t::POST_UPDATE, count_post},
+        {attribute_key(8, 1), ESP_MATTER_VAL_TYPE_UINT8, callback_type_t::PRE_UPDATE, reject},
+    };
+    const size_t count = sizeof(table) / sizeof(table[0]);
+    HOST_CHECK(attribute_handler_table_sorted(table, count));
+
+    esp_matter_attr_val_t on = esp_matter_bool(true);
+    esp_matter_attr_val_t level = esp_matter_uint8(10);
+
+    // Entries sharing a key run only in their own phase.
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 6, 0, &on) == ESP_OK);
+    HOST_CHECK(pre_calls == 1 && post_calls == 0);
+    HOST_CHECK(dispatch(table, count, callback_type_t::POST_UPDATE, 6, 0, &on) == ESP_OK);
+    HOST_CHECK(pre_calls == 1 && post_calls == 1);
+    HOST_CHECK(dispatch(table, count, callback_type_t::READ, 6, 0, &on) == ESP_OK);
+    HOST_CHECK(dispatch(table, count, callback_type_t::WRITE, 6, 0, &on) == ESP_OK);
+    // A phase without an entry is accepted, even with a value of another type.
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 8, 0, &on) == ESP_OK);
+    HOST_CHECK(pre_calls == 1 && post_calls == 1);
+
+    // A value of the wrong type, or none, is rejected without calling the handler.
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 6, 0, &level) == ESP_ERR_INVALID_ARG);
+    HOST_CHECK(dispatch(table, count, callback_type_t::POST_UPDATE, 8, 0, &on) == ESP_ERR_INVALID_ARG);
+    HOST_CHECK(dispatch(table, count, callback_type_t::POST_UPDATE, 6, 0, nullptr) == ESP_ERR_INVALID_ARG);
+    HOST_CHECK(pre_calls == 1 && post_calls == 1);
+    HOST_CHECK(dispatch(table, count, callback_type_t::POST_UPDATE, 8, 0, &level) == ESP_OK);
+    HOST_CHECK(post_calls == 2);
+
+    // Handler errors are passed on.
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 8, 1, &level) == ESP_ERR_NOT_SUPPORTED);
+
+    // Paths around and between the entries are accepted unchanged.
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 5, 0, nullptr) == ESP_OK);
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 6, 1, &on) == ESP_OK);
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 7, 0, &on) == ESP_OK);
+    HOST_CHECK(dispatch(table, count, callback_type_t::PRE_UPDATE, 9, 0, &on) == ESP_OK);
+    HOST_CHECK(dispatch(nullptr, 0, callback_type_t::PRE_UPDATE, 6, 0, &on) == ESP_OK);
+    HOST_CHECK(pre_calls == 1 && post_calls == 2);
+
+    static const attribute_handler_t unsorted[] = {
+        {attribute_key(8, 0), ESP_MATTER_VAL_TYPE_UINT8, callback_type_t::POST_UPDATE, count_post},
+        {attribute_key(6, 0), ESP_MATTER_VAL_TYPE_BOOLEAN, callback_type_t::PRE_UPDATE, count_pre},
+    };
+    HOST_CHECK(!attribute_handler_table_sorted(unsorted, 2));
+}
+
+static void test_application_table(void) {
+    uint16_t relay_endpoint_id;
+    HOST_CHECK(relay_init() == ESP_OK);
+    HOST_CHECK(matter_init(&relay_endpoint_id) == ESP_OK);
+
+    esp_matter_attr_val_t on = esp_matter_bool(true);
+    esp_matter_attr_val_t level = esp_matter_uint8(1);
+    HOST_CHECK(attribute_handlers_dispatch(callback_type_t::POST_UPDATE, relay_endpoint_id, OnOff::Id,
+                                           OnOff::Attributes::OnOff::Id, &on) == ESP_OK);
+    HOST_CHECK(!relay_get());
+    HOST_CHECK(attribute_handlers_dispatch(callback_type_t::PRE_UPDATE, relay_endpoint_id, OnOff::Id,
+                                           OnOff::Attributes::OnOff::Id, &level) == ESP_ERR_INVALID_ARG);
+    HOST_CHECK(!relay_get());
+    HOST_CHECK(attribute_handlers_dispatch(callback_type_t::PRE_UPDATE, relay_endpoint_id, OnOff::Id,
+                                           OnOff::Attributes::OnOff::Id, &on) == ESP_OK);
+    HOST_CHECK(relay_get());
+}
+
+// One handler per attribute, spread over clusters so that keys differ in both halves.
+static attribute_handler_t synthetic[MAX_HANDLERS];
+
+static void build_synthetic(void) {
+    for (size_t i = 0; i < MAX_HANDLERS; i++) {
+        synthetic[i] = {attribute_key(CLUSTER_BASE + i / 4, i % 4), ESP_MATTER_VAL_TYPE_BOOLEAN,
+                        callback_type_t::PRE_UPDATE, count_pre};
+    }
+    HOST_CHECK(attribute_handler_table_sorted(synthetic, MAX_HANDLERS));
+}
+
+static void bench_lookup(void) {
+    static size_t count;
+    static esp_matter_attr_val_t val = esp_matter_bool(true);
+    char name[64];
+
+    for (count = 1; count <= MAX_HANDLERS; count *= 2) {
+        // Cycles through every entry so the branch predictor cannot learn a single search path.
+        snprintf(name, sizeof(name), "lookup: %zu handlers, hit", count);
+        host_bench(name, 1000000, [](uint32_t i) {
+            size_t index = (i * 7919) % count;
+            host_bench_keep(attribute_handler_table_dispatch(synthetic, count, callback_type_t::PRE_UPDATE, 1,
+                                                             synthetic[index].key, &val));
+        });
+        snprintf(name, sizeof(name), "lookup: %zu handlers, other phase", count);
+        host_bench(name, 1000000, [](uint32_t i) {
+            size_t index = (i * 7919) % count;
+            host_bench_keep(attribute_handler_table_dispatch(synthetic, count, callback_type_t::POST_UPDATE, 1,
+                                                             synthetic[index].key, &val));
+        });
+        snprintf(name, sizeof(name), "lookup: %zu handlers, miss", count);
+        host_bench(name, 1000000, [](uint32_t i) {
+            size_t index = (i * 7919) % count;
+            host_bench_keep(attribute_handler_table_dispatch(synthetic, count, callback_type_t::PRE_UPDATE, 1,
+                                                             synthetic[index].key + 4, &val));
+        });
+    }
+}
+
+int main(void) {
+    test_table();
+    test_application_table();
+    build_synthetic();
+    bench_lookup();
+
+    return host_test_result();
+}
@@ -0,0 +1,126 @@
+// Pulls the end-user log through the Diagnostic Logs delegate in blocks, as the BDX transfer does for logs
+// larger than the 1024-byte inline response, and checks how over-long lines are captured.
+
+#include "host_test.h"
+#include "host_fakes.h"
+
+#include "matter_interface.h"
+#include "relay.h"
+
+#include <esp_log.h>
+#include <app/clusters/diagnostic-logs-server/DiagnosticLogsProviderDelegate.h>
+#include <string.h>
+#include <string>
+
+#define INLINE_RESPONSE_MAX 1024
+#define BDX_BLOCK_SIZE 256
+#define LINES 40
+#define LINE_MAX 128
+
+using chip::MutableByteSpan;
+using chip::Optional;
+using namespace chip::app::Clusters::DiagnosticLogs;
+
+static const char *TAG = "TEST";
+
+static DiagnosticLogsProviderDelegate *provider;
+
+// Reads the whole log of an intent block by block, the way the BDX sender drives the delegate.
+static std::string pull_log(IntentEnum intent) {
+    std::string log;
+    LogSessionHandle handle = kInvalidLogSessionHandle;
+    Optional<uint64_t> time_stamp;
+    Optional<uint64_t> time_since_boot;
+    HOST_CHECK(provider->StartLogCollection(intent, handle, time_stamp, time_since_boot) == CHIP_NO_ERROR);
+    if (handle == kInvalidLogSessionHandle) {
+        return log;
+    }
+
+    bool end = false;
+    while (!end) {
+        uint8_t block[BDX_BLOCK_SIZE];
+        MutableByteSpan span(block, sizeof(block));
+        HOST_CHECK(provider->CollectLog(handle, span, end) == CHIP_NO_ERROR);
+        log.append((const char *)span.data(), span.size());
+        if (span.size() == 0) {
+            break;
+        }
+    }
+    HOST_CHECK(provider->EndLogCollection(handle) == CHIP_NO_ERROR);
+    return log;
+}
+
+static void test_large_log(void) {
+    for (int i = 0; i < LINES; i++) {
+        ESP_LOGI(TAG, "line %02d of the end-user log", i);
+    }
+
+    size_t size = provider->GetSizeForIntent(IntentEnum::kEndUserSupport);
+    HOST_CHECK(size > INLINE_RESPONSE_MAX);
+
+    std::string log = pull_log(IntentEnum::kEndUserSupport);
+    HOST_CHECK(log.size() == size);
+    for (int i = 0; i < LINES; i++) {
+        char line[64];
+        snprintf(line, sizeof(line), "TEST: line %02d of the end-user log\n", i);
+        HOST_CHECK(log.find(line) != std::string::npos);
+    }
+
+    // The inline response carries only the first 1024 bytes; the rest needs BDX.
+    uint8_t buffer[INLINE_RESPONSE_MAX];
+    MutableByteSpan span(buffer, sizeof(buffer));
+    Optional<uint64_t> time_stamp;
+    Optional<uint64_t> time_since_boot;
+    HOST_CHECK(provider->GetLogForIntent(IntentEnum::kEndUserSupport, span, time_stamp, time_since_boot) ==
+               CHIP_NO_ERROR);
+    HOST_CHECK(span.size() == INLINE_RESPONSE_MAX);
+    HOST_CHECK(memcmp(buffer, log.data(), INLINE_RESPONSE_MAX) == 0);
+}
+
+static void test_truncated_line(void) {
+    std::string long_text(2 * LINE_MAX, 'x');
+    ESP_LOGI(TAG, "%s", long_text.c_str());
+    ESP_LOGI(TAG, "after the long line");
+
+    std::string log = pull_log(IntentEnum::kEndUserSupport);
+    size_t found = log.find(long_text.substr(0, 16));
+    HOST_CHECK(found != std::string::npos);
+    if (found == std::string::npos) {
+        return;
+    }
+
+    // The truncated line fills the capture buffer and still ends in a newline, so the next line starts
+    // on its own.
+    size_t start = log.rfind('\n', found) + 1;
+    size_t next = log.find('\n', start) + 1;
+    HOST_CHECK(next - start == LINE_MAX - 1);
+    HOST_CHECK(log.compare(next, 3, "I (") == 0);
+    HOST_CHECK(log.find("TEST: after the long line\n", next) != std::string::npos);
+}
+
+static void test_crash_log(void) {
+    // No core dump partition on the host.
+    LogSessionHandle handle = kInvalidLogSessionHandle;
+    Optional<uint64_t> time_stamp;
+    Optional<uint64_t> time_since_boot;
+    HOST_CHECK(provider->GetSizeForIntent(IntentEnum::kCrashLogs) == 0);
+    HOST_CHECK(provider->StartLogCollection(IntentEnum::kCrashLogs, handle, time_stamp, time_since_boot) ==
+               CHIP_ERROR_NOT_FOUND);
+}
+
+int main(void) {
+    uint16_t relay_endpoint;
+    HOST_CHECK(relay_init() == ESP_OK);
+    HOST_CHECK(matter_init(&relay_endpoint) == ESP_OK);
+    provider = static_cast<DiagnosticLogsProviderDelegate *>(fake_esp_matter_diagnostic_logs_delegate());
+    HOST_CHECK(provider != nullptr);
+    if (provider == nullptr) {
+        return host_test_result();
+    }
+
+    test_large_log();
+    test_truncated_line();
+    test_crash_log();
+
+    return host_test_result();
+}
@@ -0,0 +1,222 @@
+// Tests the Modbus RTU master and the relay bridge against the simulated bus, and reports the bus time
+// and host CPU time of a bridge cycle.
+
+#include "host_test.h"
+#include "host_fakes.h"
+
+#include "events.h"
+#include "matter_interface.h"
+#include "modbus_rtu.h"
+#include "relay.h"
+#include "relay_bridge.h"
+
+#include <esp_matter.h>
+#include <string.h>
+
+#define BAUD_RATE CONFIG_APP_BRIDGE_BAUD_RATE
+#define MODULES CONFIG_APP_BRIDGE_MODULE_COUNT
+#define COILS CONFIG_APP_BRIDGE_COILS_PER_MODULE
+#define FIRST_SLAVE CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS
+#define TEST_SLAVE 0x20
+
+using esp_matter::attribute::callback_type_t;
+using namespace chip::app::Clusters;
+
+static modbus_transport_t bus;
+static uint16_t first_bridged_endpoint;
+static TaskHandle_t bridge_task;
+
+static void test_frames(void) {
+    // Reference frames from the Modbus specification examples.
+    const uint8_t read_holding[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x0A};
+    HOST_CHECK(modbus_rtu_crc16(read_holding, sizeof(read_holding)) == 0xCDC5);
+
+    uint8_t frame[MODBUS_RTU_MAX_FRAME];
+    const uint8_t read_coils[] = {0x01, 0x01, 0x00, 0x00, 0x00, 0x08, 0x3D, 0xCC};
+    HOST_CHECK(modbus_rtu_build_read_coils(frame, 1, 0, 8) == sizeof(read_coils));
+    HOST_CHECK(memcmp(frame, read_coils, sizeof(read_coils)) == 0);
+
+    size_t len = modbus_rtu_build_write_coils(frame, 0x11, 0x13, 10, 0x1CD);
+    const uint8_t write_coils[] = {0x11, 0x0F, 0x00, 0x13, 0x00, 0x0A, 0x02, 0xCD, 0x01};
+    HOST_CHECK(len == sizeof(write_coils) + 2);
+    HOST_CHECK(memcmp(frame, write_coils, sizeof(write_coils)) == 0);
+    uint16_t crc = modbus_rtu_crc16(frame, len - 2);
+    HOST_CHECK(frame[len - 2] == (crc & 0xFF) && frame[len - 1] == (crc >> 8));
+
+    // The largest request still fits the frame buffer.
+    HOST_CHECK(modbus_rtu_build_write_coils(frame, 1, 0, MODBUS_RTU_MAX_COILS, 0xFFFFFFFF) <= MODBUS_RTU_MAX_FRAME);
+}
+
+static void test_transactions(void) {
+    fake_modbus_add_slave(TEST_SLAVE, 32);
+
+    uint32_t values = 0;
+    HOST_CHECK(modbus_rtu_write_coils(&bus, TEST_SLAVE, 0, 32, 0xA5A5F00F) == ESP_OK);
+    HOST_CHECK(fake_modbus_coils(TEST_SLAVE) == 0xA5A5F00F);
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 0, 32, &values) == ESP_OK);
+    HOST_CHECK(values == 0xA5A5F00F);
+
+    HOST_CHECK(modbus_rtu_write_coils(&bus, TEST_SLAVE, 4, 3, 0x5) == ESP_OK);
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 4, 3, &values) == ESP_OK);
+    HOST_CHECK(values == 0x5);
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 0, 8, &values) == ESP_OK);
+    HOST_CHECK(values == 0x5F);
+
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 0, 0, &values) == ESP_ERR_INVALID_ARG);
+    HOST_CHECK(modbus_rtu_write_coils(&bus, TEST_SLAVE, 0, MODBUS_RTU_MAX_COILS + 1, 0) == ESP_ERR_INVALID_ARG);
+
+    // Exception response for coils the slave does not have.
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 30, 8, &values) == ESP_ERR_INVALID_RESPONSE);
+
+    fake_modbus_corrupt_next_response();
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 0, 8, &values) == ESP_ERR_INVALID_CRC);
+
+    fake_modbus_set_online(TEST_SLAVE, false);
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 0, 8, &values) == ESP_ERR_TIMEOUT);
+    fake_modbus_set_online(TEST_SLAVE, true);
+    HOST_CHECK(modbus_rtu_read_coils(&bus, TEST_SLAVE, 0, 8, &values) == ESP_OK);
+}
+
+static esp_err_t switch_bridged(size_t relay, bool state) {
+    esp_matter_attr_val_t val = esp_matter_bool(state);
+    return matter_attribute_update_callback(callback_type_t::PRE_UPDATE, first_bridged_endpoint + relay, OnOff::Id,
+                                            OnOff::Attributes::OnOff::Id, &val, nullptr);
+}
+
+static bool attribute_bool(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {
+    esp_matter_attr_val_t val = {};
+    HOST_CHECK(fake_esp_matter_get(endpoint_id, cluster_id, attribute_id, &val) == ESP_OK);
+    return val.val.b;
+}
+
+// A cycle is one wait for work followed by one pass over the bus; see fake_task_run().
+static void run_bus_cycle(void) {
+    fake_task_run(bridge_task, 2);
+}
+
+static void test_bridge(void) {
+    for (size_t relay = 0; relay < MODULES * COILS; relay++) {
+        HOST_CHECK(matter_is_relay_endpoint(first_bridged_endpoint + relay));
+    }
+    HOST_CHECK(!matter_is_relay_endpoint(first_bridged_endpoint + MODULES * COILS));
+
+    // The stack must leave room for logging and Matter attribute updates.
+    HOST_CHECK(fake_task_stack_depth(bridge_task) >= 4096);
+
+    // A burst of requests across both modules goes out as one write per module.
+    fake_modbus_stats_t before = fake_modbus_stats();
+    for (size_t relay = 0; relay < MODULES * COILS; relay += 3) {
+        HOST_CHECK(switch_bridged(relay, true) == ESP_OK);
+        HOST_CHECK(matter_relay_get(first_bridged_endpoint + relay));
+    }
+    run_bus_cycle();
+    fake_modbus_stats_t after = fake_modbus_stats();
+    HOST_CHECK(after.writes - before.writes == MODULES);
+    HOST_CHECK(after.reads - before.reads == MODULES);
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE) == 0x49);
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE + 1) == 0x92);
+
+    // Nothing pending: a cycle only polls.
+    before = fake_modbus_stats();
+    run_bus_cycle();
+    after = fake_modbus_stats();
+    HOST_CHECK(after.writes == before.writes && after.reads - before.reads == MODULES);
+
+    // A coil switched on the module itself is reported to Matter.
+    fake_modbus_set_coils(FIRST_SLAVE + 1, 0x93);
+    run_bus_cycle();
+    HOST_CHECK(attribute_bool(first_bridged_endpoint + COILS, OnOff::Id, OnOff::Attributes::OnOff::Id));
+    HOST_CHECK(matter_relay_get(first_bridged_endpoint + COILS));
+
+    // An unreachable module is flagged on its endpoints and recovers on the next successful poll.
+    fake_modbus_set_online(FIRST_SLAVE + 1, false);
+    run_bus_cycle();
+    for (size_t coil = 0; coil < COILS; coil++) {
+        HOST_CHECK(!attribute_bool(first_bridged_endpoint + COILS + coil, BridgedDeviceBasicInformation::Id,
+                                   BridgedDeviceBasicInformation::Attributes::Reachable::Id));
+    }
+    HOST_CHECK(attribute_bool(first_bridged_endpoint, BridgedDeviceBasicInformation::Id,
+                              BridgedDeviceBasicInformation::Attributes::Reachable::Id));
+
+    // A request made while the module is offline is rejected, failing the attribute write, and is not
+    // written once the module is back. The other module still takes requests.
+    HOST_CHECK(switch_bridged(COILS + 2, true) == ESP_ERR_INVALID_STATE);
+    HOST_CHECK(!matter_relay_get(first_bridged_endpoint + COILS + 2));
+    HOST_CHECK(switch_bridged(1, true) == ESP_OK);
+    run_bus_cycle();
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE) == 0x4B);
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE + 1) == 0x93);
+    fake_modbus_set_online(FIRST_SLAVE + 1, true);
+    run_bus_cycle();
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE + 1) == 0x93);
+    HOST_CHECK(attribute_bool(first_bridged_endpoint + COILS, BridgedDeviceBasicInformation::Id,
+                              BridgedDeviceBasicInformation::Attributes::Reachable::Id));
+
+    // Once reachable, it takes requests again.
+    HOST_CHECK(switch_bridged(COILS + 2, true) == ESP_OK);
+    run_bus_cycle();
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE + 1) == 0x97);
+}
+
+static double bus_ms(const fake_modbus_stats_t &before, const fake_modbus_stats_t &after) {
+    return (after.bus_time_us - before.bus_time_us) / 1000.0;
+}
+
+static void bench_bridge(void) {
+    // Simulated bus time, from the frame sizes at the configured baud rate.
+    fake_modbus_stats_t before = fake_modbus_stats();
+    run_bus_cycle();
+    fake_modbus_stats_t after = fake_modbus_stats();
+    double poll_ms = bus_ms(before, after);
+    printf("%-48s %10.1f ms at %d baud\n", "bus: poll cycle, simulated", poll_ms, BAUD_RATE);
+
+    // A request waits out the settle window, then its module's write is the first frame on the bus.
+    TickType_t start = xTaskGetTickCount();
+    before = fake_modbus_stats();
+    switch_bridged(0, false);
+    run_bus_cycle();
+    after = fake_modbus_stats();
+    double settle_ms = (double)(xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+    double write_ms = bus_ms(before, after) - poll_ms;
+    printf("%-48s %10.1f ms at %d baud\n", "bus: cycle with one write, simulated", bus_ms(before, after), BAUD_RATE);
+    printf("%-48s %10.1f ms (settle %.0f ms at %d Hz + write %.1f ms)\n", "bus: request to coil, simulated",
+           settle_ms + write_ms, settle_ms, CONFIG_FREERTOS_HZ, write_ms);
+
+    host_bench("cpu: relay_bridge_set", 200000, [](uint32_t i) {
+        host_bench_keep(relay_bridge_set(first_bridged_endpoint + (i % (MODULES * COILS)), i & 1));
+    });
+    host_bench("cpu: bridge cycle, a write to every module", 20000, [](uint32_t i) {
+        for (int module = 0; module < MODULES; module++) {
+            switch_bridged(module * COILS, i & 1);
+        }
+        run_bus_cycle();
+    });
+    host_bench("cpu: bridge cycle, poll only", 20000, [](uint32_t i) { run_bus_cycle(); });
+}
+
+int main(void) {
+    fake_modbus_reset(BAUD_RATE);
+    for (int i = 0; i < MODULES; i++) {
+        fake_modbus_add_slave(FIRST_SLAVE + i, COILS);
+    }
+    fake_modbus_transport(&bus);
+
+    test_frames();
+    test_transactions();
+
+    uint16_t relay_endpoint_id;
+    HOST_CHECK(relay_init() == ESP_OK);
+    HOST_CHECK(matter_init(&relay_endpoint_id) == ESP_OK);
+    // The aggregator follows the local relay endpoint, then one endpoint per coil.
+    first_bridged_endpoint = relay_endpoint_id + 2;
+    bridge_task = fake_task_find("bridge_task");
+    HOST_CHECK(bridge_task != nullptr);
+    if (bridge_task == nullptr) {
+        return host_test_result();
+    }
+
+    test_bridge();
+    bench_bridge();
+
+    return host_test_result();
+}
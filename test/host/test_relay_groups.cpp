@@ -0,0 +1,268 @@
+// Tests the group command fan-out against the simulated interaction model group dispatch, with the local
+// relay and bridged relays on both Modbus modules in one group, and reports the actuation spread.
+
+#include "host_test.h"
+#include "host_fakes.h"
+
+#include "matter_interface.h"
+#include "relay.h"
+#include "relay_groups.h"
+
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#define MODULES CONFIG_APP_BRIDGE_MODULE_COUNT
+#define COILS CONFIG_APP_BRIDGE_COILS_PER_MODULE
+#define FIRST_SLAVE CONFIG_APP_BRIDGE_FIRST_SLAVE_ADDRESS
+
+#define FABRIC 1
+#define GROUP 0x0101
+#define CONTROLLER 0x1111
+#define OTHER_CONTROLLER 0x2222
+
+using namespace chip::app::Clusters;
+
+static uint16_t relay_endpoint;
+static uint16_t first_bridged_endpoint;
+static TaskHandle_t bridge_task;
+
+// The local relay, three coils of the first module and one of the second.
+static uint16_t members[5];
+static uint16_t non_member;
+static uint16_t exchange_id = 0;
+
+static void run_bus_cycle(void) {
+    fake_task_run(bridge_task, 2);
+}
+
+static bool attribute_on(uint16_t endpoint_id) {
+    esp_matter_attr_val_t val = {};
+    HOST_CHECK(fake_esp_matter_get(endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val) == ESP_OK);
+    return val.val.b;
+}
+
+// Counts the members whose relay and OnOff attribute are both in the given state.
+static size_t members_in_state(bool state) {
+    size_t count = 0;
+    for (uint16_t endpoint_id : members) {
+        count += matter_relay_get(endpoint_id) == state && attribute_on(endpoint_id) == state;
+    }
+    return count;
+}
+
+static void invoke(chip::CommandId command_id, chip::NodeId source = CONTROLLER) {
+    fake_group_invoke(FABRIC, GROUP, source, ++exchange_id, command_id, nullptr, nullptr);
+}
+
+static void test_fanout(void) {
+    const size_t count = sizeof(members) / sizeof(members[0]);
+
+    // One multicast command switches every member relay, and one bus cycle writes each module once.
+    fake_modbus_stats_t before = fake_modbus_stats();
+    invoke(OnOff::Commands::On::Id);
+    HOST_CHECK(members_in_state(true) == count);
+    HOST_CHECK(!matter_relay_get(non_member) && !attribute_on(non_member));
+    HOST_CHECK(fake_platform_run_work() == 1);
+    run_bus_cycle();
+    fake_modbus_stats_t after = fake_modbus_stats();
+    HOST_CHECK(after.writes - before.writes == MODULES);
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE) == 0x07);
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE + 1) == 0x01);
+
+    // Toggle flips each member exactly once, although it is dispatched once per member.
+    invoke(OnOff::Commands::Toggle::Id);
+    HOST_CHECK(members_in_state(false) == count);
+    fake_platform_run_work();
+
+    // The CommandHandler is pooled, so consecutive messages share it; each is still fanned out once,
+    // even before the previous one has been cleared.
+    invoke(OnOff::Commands::Toggle::Id);
+    HOST_CHECK(members_in_state(true) == count);
+    invoke(OnOff::Commands::Toggle::Id);
+    HOST_CHECK(members_in_state(false) == count);
+
+    // The same exchange ID from another controller is a different message.
+    fake_group_invoke(FABRIC, GROUP, OTHER_CONTROLLER, exchange_id, OnOff::Commands::Toggle::Id, nullptr, nullptr);
+    HOST_CHECK(members_in_state(true) == count);
+    HOST_CHECK(fake_platform_run_work() == 3);
+
+    // A member the group may not operate is left alone, by the fan-out as well as by the OnOff server.
+    fake_access_deny(members[1]);
+    invoke(OnOff::Commands::Off::Id);
+    HOST_CHECK(matter_relay_get(members[1]) && attribute_on(members[1]));
+    HOST_CHECK(members_in_state(false) == count - 1);
+    fake_platform_run_work();
+    run_bus_cycle();
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE) == 0x01);
+    HOST_CHECK(fake_modbus_coils(FIRST_SLAVE + 1) == 0x00);
+}
+
+// Relay count and spread reported by the fan-out, parsed from its debug log line.
+static unsigned int reported_switched = 0;
+static long long reported_spread_us = -1;
+static bool index_full = false;
+
+static int capture_vprintf(const char *fmt, va_list args) {
+    char line[256];
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+    const char *switched = strstr(line, "switched ");
+    if (switched != nullptr) {
+        sscanf(switched, "switched %u relays, actuation spread %lld us", &reported_switched, &reported_spread_us);
+    }
+    index_full |= strstr(line, "Group index full") != nullptr;
+    return len;
+}
+
+// Invokes a group command with the fan-out's log lines captured.
+static void invoke_captured(chip::GroupId group_id, chip::CommandId command_id) {
+    reported_switched = 0;
+    esp_log_level_set("*", ESP_LOG_DEBUG);
+    vprintf_like_t previous = esp_log_set_vprintf(capture_vprintf);
+    fake_group_invoke(FABRIC, group_id, CONTROLLER, ++exchange_id, command_id, nullptr, nullptr);
+    esp_log_set_vprintf(previous);
+    esp_log_level_set("*", ESP_LOG_INFO);
+    fake_platform_run_work();
+}
+
+static std::chrono::steady_clock::time_point first_switch;
+static std::chrono::steady_clock::time_point last_switch;
+static size_t switched = 0;
+
+static void record_switch(chip::EndpointId endpoint_id, void *ctx) {
+    last_switch = std::chrono::steady_clock::now();
+    if (switched++ == 0) {
+        first_switch = last_switch;
+    }
+}
+
+static void bench_fanout(void) {
+    // With the fan-out, all member relays are requested within the first dispatch.
+    invoke_captured(GROUP, OnOff::Commands::Toggle::Id);
+    HOST_CHECK(reported_spread_us >= 0);
+    printf("%-48s %10lld us\n", "group: relay request spread, fan-out", reported_spread_us);
+
+    // Without it, each relay is requested from its own dispatch, after the attribute updates of those
+    // before it.
+    fake_command_handlers_enabled(false);
+    switched = 0;
+    fake_group_invoke(FABRIC, GROUP, CONTROLLER, ++exchange_id, OnOff::Commands::Toggle::Id, record_switch, nullptr);
+    fake_command_handlers_enabled(true);
+    fake_platform_run_work();
+    HOST_CHECK(switched == sizeof(members) / sizeof(members[0]) - 1);
+    printf("%-48s %10.1f us\n", "group: relay request spread, per dispatch",
+           std::chrono::duration<double, std::micro>(last_switch - first_switch).count());
+
+    // Bridged coils are switched by the bus cycle, one write per module, so the coils on the last
+    // module land one write transaction after those on the first.
+    run_bus_cycle();
+    fake_modbus_stats_t before = fake_modbus_stats();
+    run_bus_cycle();
+    fake_modbus_stats_t middle = fake_modbus_stats();
+    invoke(OnOff::Commands::Toggle::Id);
+    fake_platform_run_work();
+    run_bus_cycle();
+    fake_modbus_stats_t after = fake_modbus_stats();
+    double write_ms = ((after.bus_time_us - middle.bus_time_us) - (middle.bus_time_us - before.bus_time_us)) /
+                      1000.0 / MODULES;
+    printf("%-48s %10.1f ms at %d baud\n", "bus: coil actuation spread, simulated", write_ms * (MODULES - 1),
+           CONFIG_APP_BRIDGE_BAUD_RATE);
+
+    host_bench("cpu: group toggle, 5 members", 100000, [](uint32_t i) {
+        invoke(OnOff::Commands::Toggle::Id);
+        fake_platform_run_work();
+    });
+}
+
+// Counts the relays in the given state, leaving out the one test_fanout denied Operate on.
+static unsigned int relays_in_state(bool state) {
+    unsigned int count = relay_get() == state;
+    for (uint16_t i = 0; i < MODULES * COILS; i++) {
+        uint16_t endpoint_id = first_bridged_endpoint + i;
+        count += endpoint_id != members[1] && matter_relay_get(endpoint_id) == state;
+    }
+    return count;
+}
+
+// Every relay, the local one and all bridged ones, fits in CONFIG_APP_GROUPS_PER_RELAY groups at once.
+static void test_index_capacity(void) {
+    // Every relay but the one denied Operate.
+    const unsigned int relays = MODULES * COILS;
+    // The local relay is already in two groups and four bridged relays in one.
+    const chip::GroupId first_group = GROUP + 2;
+    const int groups = CONFIG_APP_GROUPS_PER_RELAY - 2;
+
+    for (int g = 0; g < groups; g++) {
+        fake_group_add(FABRIC, first_group + g, relay_endpoint);
+        for (uint16_t i = 0; i < MODULES * COILS; i++) {
+            fake_group_add(FABRIC, first_group + g, first_bridged_endpoint + i);
+        }
+    }
+    relay_groups_invalidate();
+
+    index_full = false;
+    invoke_captured(first_group, OnOff::Commands::Off::Id);
+    invoke_captured(first_group + groups - 1, OnOff::Commands::On::Id);
+    HOST_CHECK(!index_full);
+    HOST_CHECK(reported_switched == relays);
+    HOST_CHECK(relays_in_state(true) == relays);
+
+    // Past the limit, the index logs an error and leaves memberships out, whose relays are still switched
+    // by their own dispatch.
+    const chip::GroupId extra_group = first_group + groups;
+    for (uint16_t i = 0; i < MODULES * COILS; i++) {
+        fake_group_add(FABRIC, extra_group, first_bridged_endpoint + i);
+        fake_group_add(FABRIC, extra_group + 1, first_bridged_endpoint + i);
+    }
+    relay_groups_invalidate();
+
+    invoke_captured(first_group, OnOff::Commands::Off::Id);
+    HOST_CHECK(index_full);
+    HOST_CHECK(relays_in_state(false) == relays);
+    invoke_captured(extra_group + 1, OnOff::Commands::On::Id);
+    HOST_CHECK(reported_switched < relays - 1);
+    HOST_CHECK(relays_in_state(true) == relays - 1);
+}
+
+int main(void) {
+    fake_modbus_reset(CONFIG_APP_BRIDGE_BAUD_RATE);
+    for (int i = 0; i < MODULES; i++) {
+        fake_modbus_add_slave(FIRST_SLAVE + i, COILS);
+    }
+
+    HOST_CHECK(relay_init() == ESP_OK);
+    HOST_CHECK(matter_init(&relay_endpoint) == ESP_OK);
+    // The group command handlers are registered from the Matter task.
+    HOST_CHECK(fake_platform_run_work() == 1);
+    first_bridged_endpoint = relay_endpoint + 2;
+    bridge_task = fake_task_find("bridge_task");
+    HOST_CHECK(bridge_task != nullptr);
+    if (bridge_task == nullptr) {
+        return host_test_result();
+    }
+
+    members[0] = relay_endpoint;
+    members[1] = first_bridged_endpoint;
+    members[2] = first_bridged_endpoint + 1;
+    members[3] = first_bridged_endpoint + 2;
+    members[4] = first_bridged_endpoint + COILS;
+    non_member = first_bridged_endpoint + 3;
+
+    fake_fabric_add(FABRIC);
+    for (uint16_t endpoint_id : members) {
+        fake_group_add(FABRIC, GROUP, endpoint_id);
+    }
+    // The aggregator has no OnOff cluster and is never dispatched to.
+    fake_group_add(FABRIC, GROUP, relay_endpoint + 1);
+    // Another group on the same relays.
+    fake_group_add(FABRIC, GROUP + 1, non_member);
+    fake_group_add(FABRIC, GROUP + 1, relay_endpoint);
+
+    test_fanout();
+    bench_fanout();
+    test_index_capacity();
+
+    return host_test_result();
+}